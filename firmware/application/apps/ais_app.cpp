@@ -267,6 +267,7 @@ AISAppView::AISAppView(NavigationView&) {
 	add_children({
 		&label_channel,
 		&options_channel,
+		&text_packet_stats,
 		&field_rf_amp,
 		&field_lna,
 		&field_vga,
@@ -340,6 +341,13 @@ void AISAppView::on_packet(const ais::Packet& packet) {
 	}
 }
 
+void AISAppView::on_packet_statistics(const PacketStatistics& statistics) {
+	text_packet_stats.set(
+		to_string_dec_uint(statistics.accepted, 3) + "/" +
+		to_string_dec_uint(statistics.rejected_length + statistics.rejected_crc, 2)
+	);
+}
+
 void AISAppView::on_show_list() {
 	recent_entries_view.hidden(false);
 	recent_entry_detail_view.hidden(true);
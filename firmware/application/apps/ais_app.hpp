@@ -103,6 +103,7 @@ public:
 	}
 	
 	void on_packet(const ais::Packet& packet);
+	void on_packet_statistics(const PacketStatistics& statistics);
 
 private:
 	LogFile log_file { };
@@ -187,6 +188,11 @@ private:
 		}
 	};
 
+	/* Packets accepted/rejected by the baseband. */
+	Text text_packet_stats {
+		{ 7 * 8, 0 * 16, 6 * 8, 1 * 16 },
+	};
+
 	RFAmpField field_rf_amp {
 		{ 13 * 8, 0 * 16 }
 	};
@@ -211,13 +217,21 @@ private:
 		Message::ID::AISPacket,
 		[this](Message* const p) {
 			const auto message = static_cast<const AISPacketMessage*>(p);
-			const ais::Packet packet { message->packet };
+			const ais::Packet packet { message->packet, message->validated };
 			if( packet.is_valid() ) {
 				this->on_packet(packet);
 			}
 		}
 	};
 
+	MessageHandlerRegistration message_handler_packet_statistics {
+		Message::ID::PacketStatistics,
+		[this](Message* const p) {
+			const auto message = static_cast<const PacketStatisticsMessage*>(p);
+			this->on_packet_statistics(message->statistics);
+		}
+	};
+
 	uint32_t target_frequency_ = initial_target_frequency;
 
 	void on_packet(const ais::Packet& packet);
@@ -55,6 +55,7 @@ private:
 			{ "DSB ", 0 },
 			{ "USB ", 0 },
 			{ "LSB ", 0 },
+			{ "CW  ", 0 },
 		}
 	};
 };
@@ -29,6 +29,8 @@ using namespace portapack;
 #include "portapack_persistent_memory.hpp"
 using namespace portapack;
 
+#include <algorithm>
+
 namespace ui {
 
 CaptureAppView::CaptureAppView(NavigationView& nav) {
@@ -43,6 +45,12 @@ CaptureAppView::CaptureAppView(NavigationView& nav) {
 		&field_lna,
 		&field_vga,
 		&record_view,
+		&options_rate,
+		&options_format,
+		&text_trigger,
+		&options_trigger,
+		&text_reserve,
+		&options_reserve,
 		&waterfall,
 	});
 
@@ -76,7 +84,31 @@ CaptureAppView::CaptureAppView(NavigationView& nav) {
 		static_cast<int8_t>(receiver_model.vga()),
 	});
 
-	record_view.set_sampling_rate(sampling_rate / 8);
+	options_rate.set_by_value(decimation_factor);
+	options_rate.on_change = [this](size_t, OptionsField::value_t v) {
+		this->decimation_factor = v;
+		this->on_capture_changed();
+	};
+
+	options_format.set_by_value(toUType(format));
+	options_format.on_change = [this](size_t, OptionsField::value_t v) {
+		this->format = static_cast<CaptureConfigureMessage::Format>(v);
+		this->on_capture_changed();
+	};
+
+	options_trigger.set_by_value(trigger_threshold_db);
+	options_trigger.on_change = [this](size_t, OptionsField::value_t v) {
+		this->trigger_threshold_db = v;
+		this->on_capture_changed();
+	};
+
+	/* Matches RecordView's default limit. */
+	options_reserve.set_by_value(1024);
+	options_reserve.on_change = [this](size_t, OptionsField::value_t v) {
+		this->record_view.set_reserve_limit(static_cast<File::Size>(v) << 20);
+	};
+
+	on_capture_changed();
 	record_view.on_error = [&nav](std::string message) {
 		nav.display_modal("Error", message);
 	};
@@ -106,6 +138,51 @@ void CaptureAppView::focus() {
 	record_view.focus();
 }
 
+void CaptureAppView::on_capture_changed() {
+	/* Close any open recording before the baseband switches, so no data in
+	 * the new configuration reaches the old file.
+	 */
+	record_view.stop();
+
+	const bool triggered = (trigger_threshold_db != 0);
+	baseband::capture_configure(
+		decimation_factor, format,
+		triggered, trigger_threshold_db, pre_trigger_ms, post_trigger_ms
+	);
+	record_view.set_segmented(triggered);
+	record_view.set_pre_trigger_us(pre_trigger_us());
+	switch(format) {
+	case CaptureConfigureMessage::Format::C8:
+		record_view.set_file_type(RecordView::FileType::RawS8);
+		break;
+
+	case CaptureConfigureMessage::Format::RiceC16:
+		record_view.set_file_type(RecordView::FileType::RiceS16);
+		break;
+
+	default:
+		record_view.set_file_type(RecordView::FileType::RawS16);
+		break;
+	}
+	record_view.set_sampling_rate(sampling_rate / decimation_factor);
+}
+
+uint32_t CaptureAppView::pre_trigger_us() const {
+	/* As kept by the baseband: whole chunks of 2048 baseband samples, as
+	 * many as fit the history held in the stream buffers. Compressed chunks
+	 * are counted at their largest size, so this is a lower bound for RIQ.
+	 */
+	constexpr size_t chunk_baseband_samples = 2048;
+	constexpr uint32_t chunk_us = chunk_baseband_samples * 1000000ULL / sampling_rate;
+	const size_t chunk_samples = chunk_baseband_samples / decimation_factor;
+	const size_t chunk_bytes =
+		(format == CaptureConfigureMessage::Format::C8) ? (chunk_samples * 2) :
+		((format == CaptureConfigureMessage::Format::RiceC16) ? (16 + chunk_samples * 4) : (chunk_samples * 4));
+	const size_t chunks_wanted = (pre_trigger_ms * 1000 + chunk_us - 1) / chunk_us;
+	const size_t chunks_fit = ((buffer_count - 2) * write_size) / chunk_bytes;
+	return std::min(chunks_wanted, chunks_fit) * chunk_us;
+}
+
 void CaptureAppView::on_target_frequency_changed(rf::Frequency f) {
 	set_target_frequency(f);
 }
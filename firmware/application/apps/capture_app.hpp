@@ -47,12 +47,32 @@ public:
 	std::string title() const override { return "Capture"; };
 
 private:
-	static constexpr ui::Dim header_height = 2 * 16;
+	static constexpr ui::Dim header_height = 3 * 16;
 
 	static constexpr uint32_t sampling_rate = 4000000;
 	static constexpr uint32_t baseband_bandwidth = 2500000;
 
+	size_t decimation_factor { 8 };
+	CaptureConfigureMessage::Format format { CaptureConfigureMessage::Format::C16 };
+
+	/* Channel peak (dBFS) that starts a segment. 0 captures continuously. */
+	int32_t trigger_threshold_db { 0 };
+	/* Pre-trigger history is also limited by the stream buffers, to about
+	 * 10ms at 1MS/s C16; see pre_trigger_us().
+	 */
+	static constexpr uint32_t pre_trigger_ms = 20;
+	static constexpr uint32_t post_trigger_ms = 250;
+
+	/* The baseband holds the pre-trigger history in the stream buffers, at
+	 * least buffer_count - 2 of them.
+	 */
+	static constexpr size_t write_size = 8192;
+	static constexpr size_t buffer_count = 7;
+
 	void on_target_frequency_changed(rf::Frequency f);
+	void on_capture_changed();
+
+	uint32_t pre_trigger_us() const;
 
 	rf::Frequency target_frequency() const;
 	void set_target_frequency(const rf::Frequency new_value);
@@ -89,7 +109,64 @@ private:
 
 	RecordView record_view {
 		{ 0 * 8, 1 * 16, 30 * 8, 1 * 16 },
-		u"BBD_????", RecordView::FileType::RawS16, 16384, 3
+		u"BBD_????", RecordView::FileType::RawS16, write_size, buffer_count
+	};
+
+	OptionsField options_rate {
+		{ 0 * 8, 2 * 16 },
+		5,
+		{
+			{ "1M   ",  4 },
+			{ "500k ",  8 },
+			{ "250k ", 16 },
+			{ "125k ", 32 },
+		}
+	};
+
+	OptionsField options_format {
+		{ 6 * 8, 2 * 16 },
+		3,
+		{
+			{ "C16", toUType(CaptureConfigureMessage::Format::C16) },
+			{ "C8 ", toUType(CaptureConfigureMessage::Format::C8) },
+			{ "RIQ", toUType(CaptureConfigureMessage::Format::RiceC16) },
+		}
+	};
+
+	Text text_trigger {
+		{ 10 * 8, 2 * 16, 4 * 8, 16 },
+		"Trig",
+	};
+
+	OptionsField options_trigger {
+		{ 15 * 8, 2 * 16 },
+		3,
+		{
+			{ "Off",   0 },
+			{ "-60", -60 },
+			{ "-50", -50 },
+			{ "-40", -40 },
+			{ "-30", -30 },
+			{ "-20", -20 },
+			{ "-10", -10 },
+		}
+	};
+
+	Text text_reserve {
+		{ 19 * 8, 2 * 16, 3 * 8, 16 },
+		"Rsv",
+	};
+
+	/* Space reserved up front for a capture file, MiB. */
+	OptionsField options_reserve {
+		{ 23 * 8, 2 * 16 },
+		4,
+		{
+			{ "Off ",    0 },
+			{ "64M ",   64 },
+			{ "256M",  256 },
+			{ "1G  ", 1024 },
+		}
 	};
 
 	spectrum::WaterfallWidget waterfall { };
@@ -98,6 +98,7 @@ ERTAppView::ERTAppView(NavigationView&) {
 	baseband::run_image(portapack::spi_flash::image_tag_ert);
 
 	add_children({
+		&text_packet_stats,
 		&field_rf_amp,
 		&field_lna,
 		&field_vga,
@@ -148,6 +149,13 @@ void ERTAppView::on_packet(const ert::Packet& packet) {
 	}
 }
 
+void ERTAppView::on_packet_statistics(const PacketStatistics& statistics) {
+	text_packet_stats.set(
+		to_string_dec_uint(statistics.accepted, 5) + "/" +
+		to_string_dec_uint(statistics.rejected_length + statistics.rejected_crc, 5)
+	);
+}
+
 void ERTAppView::on_show_list() {
 	recent_entries_view.hidden(false);
 	recent_entries_view.focus();
@@ -95,6 +95,7 @@ public:
 	}
 	
 	void on_packet(const ert::Packet& packet);
+	void on_packet_statistics(const PacketStatistics& statistics);
 
 private:
 	LogFile log_file { };
@@ -139,6 +140,11 @@ private:
 
 	static constexpr auto header_height = 1 * 16;
 
+	/* Packets accepted/rejected by the baseband. */
+	Text text_packet_stats {
+		{ 0 * 8, 0 * 16, 12 * 8, 1 * 16 },
+	};
+
 	RFAmpField field_rf_amp {
 		{ 13 * 8, 0 * 16 }
 	};
@@ -159,11 +165,19 @@ private:
 		Message::ID::ERTPacket,
 		[this](Message* const p) {
 			const auto message = static_cast<const ERTPacketMessage*>(p);
-			const ert::Packet packet { message->type, message->packet };
+			const ert::Packet packet { message->type, message->packet, message->validated };
 			this->on_packet(packet);
 		}
 	};
 
+	MessageHandlerRegistration message_handler_packet_statistics {
+		Message::ID::PacketStatistics,
+		[this](Message* const p) {
+			const auto message = static_cast<const PacketStatisticsMessage*>(p);
+			this->on_packet_statistics(message->statistics);
+		}
+	};
+
 	void on_packet(const ert::Packet& packet);
 	void on_show_list();
 };
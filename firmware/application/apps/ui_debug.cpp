@@ -30,6 +30,8 @@
 
 #include "ui_sd_card_debug.hpp"
 
+#include "file.hpp"
+
 #include "portapack.hpp"
 using namespace portapack;
 
@@ -317,6 +319,140 @@ void DebugControlsView::focus() {
 	switches_widget.focus();
 }
 
+/* MessageQueueStatsWidget *********************************************/
+
+static std::string message_queue_counters_row(
+	const size_t id,
+	const MessageQueueStatistics::Counters& c
+) {
+	const auto latency_avg = c.dispatched ? (c.latency_total / c.dispatched) : 0;
+	return to_string_dec_uint(id, 2) + " "
+		+ to_string_dec_uint(c.pushed, 5) + " "
+		+ to_string_dec_uint(c.dropped, 4) + " "
+		+ to_string_dec_uint(c.bytes / 1024, 4) + " "
+		+ to_string_dec_uint(latency_avg, 5) + " "
+		+ to_string_dec_uint(c.latency_max, 5);
+}
+
+static std::string message_queue_high_water(
+	const std::string& name,
+	const MessageQueue& queue
+) {
+	return name + " high water "
+		+ to_string_dec_uint(queue.statistics().high_water, 4) + "/"
+		+ to_string_dec_uint(queue.capacity());
+}
+
+void MessageQueueStatsWidget::update() {
+	set_dirty();
+}
+
+void MessageQueueStatsWidget::paint(Painter& painter) {
+	const auto rect = screen_rect();
+	painter.fill_rectangle(rect, style().background);
+
+	/* Only message types that have been seen, as many as fit. */
+	Coord y = rect.top();
+	const auto& by_id = queue.statistics().by_id;
+	for(size_t id=0; id<by_id.size(); id++) {
+		const auto& c = by_id[id];
+		if( (c.pushed == 0) && (c.dropped == 0) ) {
+			continue;
+		}
+		if( (y + static_cast<Coord>(row_height)) > rect.bottom() ) {
+			break;
+		}
+		painter.draw_string({ rect.left(), y }, style(), message_queue_counters_row(id, c));
+		y += row_height;
+	}
+}
+
+/* DebugMessageQueuesView ************************************************/
+
+DebugMessageQueuesView::DebugMessageQueuesView(NavigationView& nav) {
+	add_children({
+		&text_title,
+		&text_application_queue,
+		&text_baseband_queue,
+		&text_app_local_queue,
+		&text_header,
+		&stats_widget,
+		&text_status,
+		&button_update,
+		&button_dump,
+		&button_done,
+	});
+
+	button_update.on_select = [this](Button&){
+		this->update();
+	};
+	button_dump.on_select = [this](Button&){
+		this->dump();
+	};
+	button_done.on_select = [&nav](Button&){ nav.pop(); };
+
+	update();
+}
+
+void DebugMessageQueuesView::focus() {
+	button_done.focus();
+}
+
+void DebugMessageQueuesView::update() {
+	text_application_queue.set(message_queue_high_water("M4>M0", shared_memory.application_queue));
+	text_baseband_queue.set(message_queue_high_water("M0>M4", shared_memory.baseband_queue));
+	text_app_local_queue.set(message_queue_high_water("Local", shared_memory.app_local_queue));
+	stats_widget.update();
+}
+
+static Optional<File::Error> write_message_queue_statistics(
+	File& file,
+	const std::string& name,
+	const MessageQueue& queue
+) {
+	const auto error_high_water = file.write_line(message_queue_high_water(name, queue));
+	if( error_high_water.is_valid() ) {
+		return error_high_water;
+	}
+
+	const auto& by_id = queue.statistics().by_id;
+	for(size_t id=0; id<by_id.size(); id++) {
+		const auto error_row = file.write_line(message_queue_counters_row(id, by_id[id]));
+		if( error_row.is_valid() ) {
+			return error_row;
+		}
+	}
+	return { };
+}
+
+void DebugMessageQueuesView::dump() {
+	update();
+
+	auto path = next_filename_stem_matching_pattern(u"IPC_????");
+	if( path.empty() ) {
+		text_status.set("No free file name");
+		return;
+	}
+	path.replace_extension(u".TXT");
+
+	File file;
+	auto error = file.create(path);
+	if( !error.is_valid() ) {
+		error = file.write_line("ID  Push Drop  KiB AvgUs MaxUs");
+	}
+	if( !error.is_valid() ) {
+		error = write_message_queue_statistics(file, "M4>M0", shared_memory.application_queue);
+	}
+	if( !error.is_valid() ) {
+		error = write_message_queue_statistics(file, "M0>M4", shared_memory.baseband_queue);
+	}
+	if( !error.is_valid() ) {
+		error = write_message_queue_statistics(file, "Local", shared_memory.app_local_queue);
+	}
+
+	text_status.set(error.is_valid() ? error.value().what() : ("Saved " + path.string()));
+}
+
 /* DebugPeripheralsMenuView **********************************************/
 
 DebugPeripheralsMenuView::DebugPeripheralsMenuView(NavigationView& nav) {
@@ -348,6 +484,7 @@ DebugPeripheralsMenuView::DebugPeripheralsMenuView(NavigationView& nav) {
 DebugMenuView::DebugMenuView(NavigationView& nav) {
 	add_items({
 		{ "Memory",      [&nav](){ nav.push<DebugMemoryView>(); } },
+		{ "IPC Queues",  [&nav](){ nav.push<DebugMessageQueuesView>(); } },
 		{ "Radio State", [&nav](){ nav.push<NotImplementedView>(); } },
 		{ "SD Card",     [&nav](){ nav.push<SDCardDebugView>(); } },
 		{ "Peripherals", [&nav](){ nav.push<DebugPeripheralsMenuView>(); } },
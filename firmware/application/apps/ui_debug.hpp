@@ -30,6 +30,7 @@
 
 #include "rffc507x.hpp"
 #include "portapack.hpp"
+#include "portapack_shared_memory.hpp"
 
 #include <functional>
 #include <utility>
@@ -267,6 +268,83 @@ private:
 	};
 };
 
+class MessageQueueStatsWidget : public Widget {
+public:
+	MessageQueueStatsWidget(
+		Rect parent_rect,
+		const MessageQueue& queue
+	) : Widget { parent_rect },
+		queue(queue)
+	{
+	}
+
+	void update();
+
+	void paint(Painter& painter) override;
+
+private:
+	const MessageQueue& queue;
+
+	static constexpr size_t row_height = 16;
+};
+
+class DebugMessageQueuesView : public View {
+public:
+	explicit DebugMessageQueuesView(NavigationView& nav);
+
+	void focus() override;
+
+private:
+	Text text_title {
+		{ 76, 16, 88, 16 },
+		"IPC Queues",
+	};
+
+	Text text_application_queue {
+		{ 0, 40, 240, 16 },
+	};
+
+	Text text_baseband_queue {
+		{ 0, 56, 240, 16 },
+	};
+
+	Text text_app_local_queue {
+		{ 0, 72, 240, 16 },
+	};
+
+	Text text_header {
+		{ 0, 96, 240, 16 },
+		"ID  Push Drop  KiB AvgUs MaxUs",
+	};
+
+	MessageQueueStatsWidget stats_widget {
+		{ 0, 112, 240, 128 },
+		shared_memory.application_queue
+	};
+
+	Text text_status {
+		{ 0, 240, 240, 16 },
+	};
+
+	Button button_update {
+		{ 8, 264, 64, 24 },
+		"Update"
+	};
+
+	Button button_dump {
+		{ 88, 264, 64, 24 },
+		"Dump"
+	};
+
+	Button button_done {
+		{ 168, 264, 64, 24 },
+		"Done"
+	};
+
+	void update();
+	void dump();
+};
+
 class DebugPeripheralsMenuView : public MenuView {
 public:
 	DebugPeripheralsMenuView(NavigationView& nav);
@@ -30,12 +30,42 @@
 
 namespace baseband {
 
-static void send_message(const Message* const message) {
-	// If message is only sent by this function via one thread, no need to check if
-	// another message is present before setting new message.
-	shared_memory.baseband_message = message;
-	creg::m0apptxevent::assert_event();
-	while(shared_memory.baseband_message);
+/* Number of the last message queued to the baseband. The baseband handles
+ * messages in order, counting them in shared_memory.baseband_completed.
+ */
+static uint32_t sequence = 0;
+
+/* Queues a copy of the message and returns without waiting for the
+ * baseband to handle it.
+ */
+template<typename T>
+static uint32_t send_message(const T& message) {
+	while( !shared_memory.baseband_queue.push(message) ) {
+		chThdYield();
+	}
+	return ++sequence;
+}
+
+uint32_t last_sent() {
+	return sequence;
+}
+
+bool is_complete(const uint32_t message_sequence) {
+	return static_cast<int32_t>(shared_memory.baseband_completed - message_sequence) >= 0;
+}
+
+void wait_for(const uint32_t message_sequence) {
+	while( !is_complete(message_sequence) ) {
+		chThdYield();
+	}
+}
+
+/* For messages the baseband acts on using M0 memory, or that must take
+ * effect before the caller continues.
+ */
+template<typename T>
+static void send_message_and_wait(const T& message) {
+	wait_for(send_message(message));
 }
 
 void AMConfig::apply() const {
@@ -43,11 +73,14 @@ void AMConfig::apply() const {
 		taps_6k0_decim_0,
 		taps_6k0_decim_1,
 		taps_6k0_decim_2,
-		channel,
+		channel ? *channel : fir_taps_complex<64> { },
 		modulation,
+		passband_low_hz,
+		passband_high_hz,
+		bfo_hz,
 		audio_12k_hpf_300hz_config
 	};
-	send_message(&message);
+	send_message(message);
 	audio::set_rate(audio::Rate::Hz_12000);
 }
 
@@ -61,7 +94,7 @@ void NBFMConfig::apply() const {
 		audio_24k_hpf_300hz_config,
 		audio_24k_deemph_300_6_config
 	};
-	send_message(&message);
+	send_message(message);
 	audio::set_rate(audio::Rate::Hz_24000);
 }
 
@@ -74,7 +107,7 @@ void WFMConfig::apply() const {
 		audio_48k_hpf_30hz_config,
 		audio_48k_deemph_2122_6_config
 	};
-	send_message(&message);
+	send_message(message);
 	audio::set_rate(audio::Rate::Hz_48000);
 }
 
@@ -87,6 +120,10 @@ void run_image(const portapack::spi_flash::image_tag_t image_tag) {
 
 	creg::m4txevent::clear();
 
+	shared_memory.baseband_queue.reset();
+	shared_memory.baseband_completed = 0;
+	sequence = 0;
+
 	m4_init(image_tag, portapack::memory::map::m4_code, false);
 	baseband_image_running = true;
 
@@ -101,7 +138,7 @@ void shutdown() {
 	creg::m4txevent::disable();
 
 	ShutdownMessage message;
-	send_message(&message);
+	send_message_and_wait(message);
 
 	shared_memory.application_queue.reset();
 	
@@ -112,24 +149,39 @@ void spectrum_streaming_start() {
 	SpectrumStreamingConfigMessage message {
 		SpectrumStreamingConfigMessage::Mode::Running
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void spectrum_streaming_stop() {
 	SpectrumStreamingConfigMessage message {
 		SpectrumStreamingConfigMessage::Mode::Stopped
 	};
-	send_message(&message);
+	send_message(message);
+}
+
+void capture_configure(
+	const size_t decimation_factor,
+	const CaptureConfigureMessage::Format format,
+	const bool triggered,
+	const int32_t trigger_threshold_db,
+	const uint32_t pre_trigger_ms,
+	const uint32_t post_trigger_ms
+) {
+	const CaptureConfigureMessage message {
+		decimation_factor, format,
+		triggered, trigger_threshold_db, pre_trigger_ms, post_trigger_ms
+	};
+	send_message(message);
 }
 
 void capture_start(CaptureConfig* const config) {
 	CaptureConfigMessage message { config };
-	send_message(&message);
+	send_message_and_wait(message);
 }
 
 void capture_stop() {
 	CaptureConfigMessage message { nullptr };
-	send_message(&message);
+	send_message_and_wait(message);
 }
 
 } /* namespace baseband */
@@ -33,8 +33,12 @@
 namespace baseband {
 
 struct AMConfig {
-	const fir_taps_complex<64> channel;
+	/* DSB only, nullptr otherwise. */
+	const fir_taps_complex<64>* const channel;
 	const AMConfigureMessage::Modulation modulation;
+	const int32_t passband_low_hz;
+	const int32_t passband_high_hz;
+	const int32_t bfo_hz;
 
 	void apply() const;
 };
@@ -53,11 +57,25 @@ struct WFMConfig {
 };
 
 void run_image(const portapack::spi_flash::image_tag_t image_tag);
+
+/* Messages are numbered from 1 in the order they are sent. */
+uint32_t last_sent();
+bool is_complete(const uint32_t message_sequence);
+void wait_for(const uint32_t message_sequence);
+
 void shutdown();
 
 void spectrum_streaming_start();
 void spectrum_streaming_stop();
 
+void capture_configure(
+	const size_t decimation_factor,
+	const CaptureConfigureMessage::Format format,
+	const bool triggered = false,
+	const int32_t trigger_threshold_db = 0,
+	const uint32_t pre_trigger_ms = 0,
+	const uint32_t post_trigger_ms = 0
+);
 void capture_start(CaptureConfig* const config);
 void capture_stop();
 
@@ -22,7 +22,8 @@
 #include "capture_thread.hpp"
 
 #include "baseband_api.hpp"
-#include "buffer_exchange.hpp"
+
+#include <array>
 
 struct BasebandCapture {
 	BasebandCapture(CaptureConfig* const config) {
@@ -77,13 +78,59 @@ Optional<File::Error> CaptureThread::run() {
 	BufferExchange buffers { &config };
 
 	while( !chThdShouldTerminate() ) {
-		auto buffer = buffers.get();
-		auto write_result = writer->write(buffer->data(), buffer->size());
-		if( write_result.is_error() ) {
-			return write_result.error();
+		/* Wait for one full buffer, then take every other one that is ready. */
+		std::array<StreamBuffer*, CaptureConfig::buffer_count_max> ready;
+		size_t ready_count = 0;
+		ready[ready_count++] = buffers.get();
+		while( (ready_count < ready.size()) && !buffers.empty() ) {
+			ready[ready_count++] = buffers.get();
+		}
+
+		const auto write_error = write(buffers, ready.data(), ready_count);
+		if( write_error.is_valid() ) {
+			return write_error;
+		}
+	}
+
+	return { };
+}
+
+Optional<File::Error> CaptureThread::write(BufferExchange& buffers, StreamBuffer* const * const ready, const size_t count) {
+	/* StreamInput carves its buffers from one allocation and cycles them in
+	 * order, so consecutive buffers are usually adjacent in memory. Each
+	 * adjacent run goes to the card as a single write. A run stops at the
+	 * end of a segment. Buffers go back to the M4 as soon as their run is
+	 * written, not after the whole batch.
+	 */
+	size_t first = 0;
+	while( first < count ) {
+		const auto run_data = static_cast<const uint8_t*>(ready[first]->data());
+		size_t run_size = ready[first]->size();
+		size_t next = first + 1;
+		while( (next < count) && !ready[next - 1]->is_segment_end() && (ready[next]->data() == (run_data + run_size)) ) {
+			run_size += ready[next]->size();
+			next++;
+		}
+
+		if( run_size ) {
+			auto write_result = writer->write(run_data, run_size);
+			if( write_result.is_error() ) {
+				return write_result.error();
+			}
+		}
+
+		if( ready[next - 1]->is_segment_end() ) {
+			const auto segment_error = writer->segment_end();
+			if( segment_error.is_valid() ) {
+				return segment_error;
+			}
+		}
+
+		for(size_t i=first; i<next; i++) {
+			ready[i]->empty();
+			buffers.put(ready[i]);
 		}
-		buffer->empty();
-		buffers.put(buffer);
+		first = next;
 	}
 
 	return { };
@@ -28,6 +28,7 @@
 
 #include "io.hpp"
 #include "optional.hpp"
+#include "buffer_exchange.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -63,6 +64,7 @@ private:
 	static msg_t static_fn(void* arg);
 
 	Optional<File::Error> run();
+	Optional<File::Error> write(BufferExchange& buffers, StreamBuffer* const * const ready, const size_t count);
 };
 
 #endif/*__CAPTURE_THREAD_H__*/
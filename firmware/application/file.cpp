@@ -96,6 +96,24 @@ File::Result<File::Offset> File::seek(const Offset new_position) {
 	return { static_cast<File::Offset>(old_position) };
 }
 
+Optional<File::Error> File::expand(const Size size) {
+	const auto result = f_expand(&f, size, 1);
+	if( result == FR_OK ) {
+		return { };
+	} else {
+		return { result };
+	}
+}
+
+Optional<File::Error> File::truncate() {
+	const auto result = f_truncate(&f);
+	if( result == FR_OK ) {
+		return { };
+	} else {
+		return { result };
+	}
+}
+
 Optional<File::Error> File::write_line(const std::string& s) {
 	const auto result_s = write(s.c_str(), s.size());
 	if( result_s.is_error() ) {
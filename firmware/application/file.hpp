@@ -316,6 +316,14 @@ public:
 
 	Result<Offset> seek(const uint64_t Offset);
 
+	/* Allocates a contiguous block of clusters for an empty file, making it
+	 * size bytes long. Fails with FR_DENIED if there is no such block.
+	 */
+	Optional<Error> expand(const Size size);
+
+	/* Discards everything after the current position. */
+	Optional<Error> truncate();
+
 	template<size_t N>
 	Result<Size> write(const std::array<uint8_t, N>& data) {
 		return write(data.data(), N);
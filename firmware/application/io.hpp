@@ -22,6 +22,7 @@
 #pragma once
 
 #include "file.hpp"
+#include "optional.hpp"
 
 namespace stream {
 
@@ -34,6 +35,8 @@ public:
 class Writer {
 public:
 	virtual File::Result<File::Size> write(const void* const buffer, const File::Size bytes) = 0;
+	/* Called after the last write of each segment of a triggered capture. */
+	virtual Optional<File::Error> segment_end() { return { }; };
 	virtual ~Writer() = default;
 };
 
@@ -21,6 +21,51 @@
 
 #include "io_file.hpp"
 
+#include "string_format.hpp"
+
+#include "lpc43xx_cpp.hpp"
+using namespace lpc43xx;
+
+FileWriter::~FileWriter() {
+	if( reserved_size ) {
+		file.truncate();
+	}
+}
+
+Optional<File::Error> FileWriter::create(
+	const std::filesystem::path& filename,
+	const File::Size reserve_size
+) {
+	const auto create_error = file.create(filename);
+	if( create_error.is_valid() ) {
+		return create_error;
+	}
+	if( reserve_size ) {
+		reserve(reserve_size);
+	}
+	return { };
+}
+
+void FileWriter::reserve(const File::Size size) {
+	/* A fragmented card may not have one block that large. Settle for less,
+	 * or for allocating on the fly as before. Each failed attempt scans the
+	 * whole FAT on the UI thread, so only a few are made.
+	 */
+	constexpr File::Size reserve_size_min = 1U << 20;
+	constexpr size_t attempts_max = 3;
+	auto n = size;
+	for(size_t i=0; (i<attempts_max) && (n>=reserve_size_min); i++, n/=4) {
+		if( !file.expand(n).is_valid() ) {
+			/* Commit the allocation now, so it isn't lost clusters after a
+			 * crash or power loss.
+			 */
+			file.sync();
+			reserved_size = n;
+			return;
+		}
+	}
+}
+
 File::Result<File::Size> FileWriter::write(const void* const buffer, const File::Size bytes) {
 	auto write_result = file.write(buffer, bytes) ;
 	if( write_result.is_ok() ) {
@@ -28,3 +73,65 @@ File::Result<File::Size> FileWriter::write(const void* const buffer, const File:
 	}
 	return write_result;
 }
+
+SegmentedFileWriter::SegmentedFileWriter(
+	const std::filesystem::path& stem,
+	const std::filesystem::path& extension
+) : stem { stem },
+	extension { extension }
+{
+}
+
+SegmentedFileWriter::~SegmentedFileWriter() {
+	/* Keep the index complete when stopped during a segment. */
+	segment_end();
+}
+
+Optional<File::Error> SegmentedFileWriter::create() {
+	auto index_path = stem;
+	return index.create(index_path.replace_extension(u".IDX"));
+}
+
+File::Result<File::Size> SegmentedFileWriter::write(const void* const buffer, const File::Size bytes) {
+	if( !segment ) {
+		segment_count++;
+		segment_path = stem;
+		segment_path += std::filesystem::path { "_" + to_string_dec_uint(segment_count, 4, '0') };
+		segment_path += extension;
+
+		auto p = std::make_unique<FileWriter>();
+		const auto create_error = p->create(segment_path);
+		if( create_error.is_valid() ) {
+			return create_error.value();
+		}
+		segment = std::move(p);
+		segment_bytes = 0;
+
+		rtc::RTC datetime;
+		rtcGetTime(&RTCD1, &datetime);
+		segment_timestamp = to_string_timestamp(datetime);
+	}
+
+	auto write_result = segment->write(buffer, bytes);
+	if( write_result.is_ok() ) {
+		segment_bytes += write_result.value();
+	}
+	return write_result;
+}
+
+Optional<File::Error> SegmentedFileWriter::segment_end() {
+	if( !segment ) {
+		return { };
+	}
+	segment.reset();
+
+	const auto error = index.write_line(
+		segment_timestamp + " " +
+		segment_path.filename().string() + " " +
+		to_string_dec_uint(segment_bytes)
+	);
+	if( error.is_valid() ) {
+		return error;
+	}
+	return index.sync();
+}
@@ -27,6 +27,8 @@
 #include "optional.hpp"
 
 #include <cstdint>
+#include <memory>
+#include <string>
 
 class FileWriter : public stream::Writer {
 public:
@@ -37,15 +39,65 @@ public:
 	FileWriter(FileWriter&& file) = delete;
 	FileWriter& operator=(FileWriter&&) = delete;
 
-	Optional<File::Error> create(const std::filesystem::path& filename) {
-		return file.create(filename);
-	}
+	~FileWriter();
+
+	/* reserve_size > 0 pre-allocates contiguous space, so clusters are not
+	 * allocated while streaming. The unused tail is released on destruction.
+	 */
+	Optional<File::Error> create(
+		const std::filesystem::path& filename,
+		const File::Size reserve_size = 0
+	);
 
 	File::Result<File::Size> write(const void* const buffer, const File::Size bytes) override;
+
+	File::Size reserved() const {
+		return reserved_size;
+	}
 	
 protected:
 	File file { };
 	uint64_t bytes_written { 0 };
+
+private:
+	File::Size reserved_size { 0 };
+
+	void reserve(const File::Size size);
 };
 
 using RawFileWriter = FileWriter;
+
+/* Writes each segment of a triggered capture to its own file,
+ * <stem>_NNNN<extension>, created when the segment's first data arrives.
+ * Finished segments are listed in <stem>.IDX, one line each:
+ * start timestamp, file name, size in bytes.
+ */
+class SegmentedFileWriter : public stream::Writer {
+public:
+	SegmentedFileWriter(
+		const std::filesystem::path& stem,
+		const std::filesystem::path& extension
+	);
+
+	SegmentedFileWriter(const SegmentedFileWriter&) = delete;
+	SegmentedFileWriter& operator=(const SegmentedFileWriter&) = delete;
+	SegmentedFileWriter(SegmentedFileWriter&& file) = delete;
+	SegmentedFileWriter& operator=(SegmentedFileWriter&&) = delete;
+
+	~SegmentedFileWriter();
+
+	Optional<File::Error> create();
+
+	File::Result<File::Size> write(const void* const buffer, const File::Size bytes) override;
+	Optional<File::Error> segment_end() override;
+
+private:
+	const std::filesystem::path stem;
+	const std::filesystem::path extension;
+	File index { };
+	std::unique_ptr<FileWriter> segment { };
+	std::filesystem::path segment_path { };
+	std::string segment_timestamp { };
+	File::Size segment_bytes { 0 };
+	size_t segment_count { 0 };
+};
@@ -23,10 +23,11 @@
 
 Optional<File::Error> WAVFileWriter::create(
 	const std::filesystem::path& filename,
-	size_t sampling_rate
+	size_t sampling_rate,
+	const File::Size reserve_size
 ) {
 	sampling_rate = sampling_rate;
-	const auto create_error = FileWriter::create(filename);
+	const auto create_error = FileWriter::create(filename, reserve_size);
 	if( create_error.is_valid() ) {
 		return create_error;
 	} else {
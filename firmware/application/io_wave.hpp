@@ -99,7 +99,8 @@ public:
 
 	Optional<File::Error> create(
 		const std::filesystem::path& filename,
-		size_t sampling_rate
+		size_t sampling_rate,
+		const File::Size reserve_size = 0
 	);
 
 private:
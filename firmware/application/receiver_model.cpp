@@ -35,10 +35,11 @@ using namespace portapack;
 
 namespace {
 
-static constexpr std::array<baseband::AMConfig, 3> am_configs { {
-	{ taps_6k0_dsb_channel, AMConfigureMessage::Modulation::DSB },
-	{ taps_2k8_usb_channel, AMConfigureMessage::Modulation::SSB },
-	{ taps_2k8_lsb_channel, AMConfigureMessage::Modulation::SSB },	
+static constexpr std::array<baseband::AMConfig, 4> am_configs { {
+	{ &taps_6k0_dsb_channel, AMConfigureMessage::Modulation::DSB,   0,    0,   0 },
+	{ nullptr,               AMConfigureMessage::Modulation::USB, 300, 2800,   0 },
+	{ nullptr,               AMConfigureMessage::Modulation::LSB, 300, 2800,   0 },
+	{ nullptr,               AMConfigureMessage::Modulation::CW,  450,  950, 700 },
 } };
 
 static constexpr std::array<baseband::NBFMConfig, 3> nbfm_configs { {
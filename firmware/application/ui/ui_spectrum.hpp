@@ -104,9 +104,9 @@ private:
 		Message::ID::DisplayFrameSync,
 		[this](const Message* const) {
 			if( this->fifo ) {
-				ChannelSpectrum channel_spectrum;
-				while( fifo->out(channel_spectrum) ) {
-					this->on_channel_spectrum(channel_spectrum);
+				while( const auto channel_spectrum = fifo->peek() ) {
+					this->on_channel_spectrum(*channel_spectrum);
+					fifo->release();
 				}
 			}
 		}
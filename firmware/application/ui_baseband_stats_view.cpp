@@ -36,6 +36,8 @@ namespace ui {
 BasebandStatsView::BasebandStatsView() {
 	add_children({
 		&text_stats,
+		&text_events,
+		&text_idle,
 	});
 }
 
@@ -57,6 +59,24 @@ void BasebandStatsView::on_statistics_update(const BasebandStatistics& statistic
 		+ " " + ticks_to_percent_string(statistics.baseband_ticks);
 
 	text_stats.set(message);
+
+	/* M4-to-M0 interrupts per second, out of messages posted. */
+	text_events.set(
+		to_string_dec_uint(statistics.events_signalled) + "/" +
+		to_string_dec_uint(statistics.events_requested)
+	);
+
+	/* Share of audio channel blocks spent on the squelch idle path. */
+	if( statistics.channel_blocks ) {
+		const uint32_t idle_x10 = statistics.channel_idle_blocks * 1000 / statistics.channel_blocks;
+		text_idle.set(
+			"Idle " +
+			to_string_dec_uint(idle_x10 / 10, 3) + "." +
+			to_string_dec_uint(idle_x10 % 10, 1) + "%"
+		);
+	} else {
+		text_idle.set("");
+	}
 }
 
 } /* namespace ui */
@@ -40,6 +40,16 @@ private:
 		"",
 	};
 
+	Text text_events {
+		{ 20 * 8, 0, 10 * 8, 1 * 16 },
+		"",
+	};
+
+	Text text_idle {
+		{  0 * 8, 1 * 16, 30 * 8, 1 * 16 },
+		"",
+	};
+
 	MessageHandlerRegistration message_handler_stats {
 		Message::ID::BasebandStatistics,
 		[this](const Message* const p) {
@@ -102,6 +102,38 @@ void RecordView::toggle() {
 	}
 }
 
+void RecordView::set_file_type(const FileType v) {
+	if( v != file_type ) {
+		stop();
+		file_type = v;
+		update_status_display();
+	}
+}
+
+void RecordView::set_segmented(const bool v) {
+	if( v != segmented ) {
+		stop();
+		segmented = v;
+		update_status_display();
+	}
+}
+
+void RecordView::set_pre_trigger_us(const uint32_t v) {
+	pre_trigger_us = v;
+}
+
+void RecordView::set_reserve_limit(const File::Size new_reserve_limit) {
+	reserve_limit = new_reserve_limit;
+}
+
+File::Size RecordView::reserve_size() const {
+	const auto space_info = std::filesystem::space(u"");
+	if( space_info.free <= reserve_headroom ) {
+		return 0;
+	}
+	return std::min(space_info.free - reserve_headroom, reserve_limit);
+}
+
 void RecordView::start() {
 	stop();
 
@@ -122,16 +154,19 @@ void RecordView::start() {
 	case FileType::WAV:
 		{
 			auto p = std::make_unique<WAVFileWriter>();
-			auto create_error = p->create(base_path.replace_extension(u".WAV"), sampling_rate);
+			auto create_error = p->create(base_path.replace_extension(u".WAV"), sampling_rate, reserve_size());
 			if( create_error.is_valid() ) {
 				handle_error(create_error.value());
 			} else {
+				reserved = p->reserved();
 				writer = std::move(p);
 			}
 		}
 		break;
 
+	case FileType::RawS8:
 	case FileType::RawS16:
+	case FileType::RiceS16:
 		{
 			const auto metadata_file_error = write_metadata_file(base_path.replace_extension(u".TXT"));
 			if( metadata_file_error.is_valid() ) {
@@ -139,12 +174,30 @@ void RecordView::start() {
 				return;
 			}
 
-			auto p = std::make_unique<RawFileWriter>();
-			auto create_error = p->create(base_path.replace_extension(u".C16"));
-			if( create_error.is_valid() ) {
-				handle_error(create_error.value());
+			const auto extension =
+				(file_type == FileType::RawS8) ? u".C8" :
+				((file_type == FileType::RiceS16) ? u".RIQ" : u".C16");
+			if( segmented ) {
+				/* Segments are short and created on the fly, so no space is
+				 * reserved for them.
+				 */
+				auto p = std::make_unique<SegmentedFileWriter>(base_path.replace_extension(), extension);
+				auto create_error = p->create();
+				if( create_error.is_valid() ) {
+					handle_error(create_error.value());
+				} else {
+					reserved = 0;
+					writer = std::move(p);
+				}
 			} else {
-				writer = std::move(p);
+				auto p = std::make_unique<RawFileWriter>();
+				auto create_error = p->create(base_path.replace_extension(extension), reserve_size());
+				if( create_error.is_valid() ) {
+					handle_error(create_error.value());
+				} else {
+					reserved = p->reserved();
+					writer = std::move(p);
+				}
 			}
 		}
 		break;
@@ -202,6 +255,12 @@ Optional<File::Error> RecordView::write_metadata_file(const std::filesystem::pat
 		if( error_line2.is_valid() ) {
 			return error_line2;
 		}
+		if( segmented ) {
+			const auto error_line3 = file.write_line("pre_trigger_us=" + to_string_dec_uint(pre_trigger_us));
+			if( error_line3.is_valid() ) {
+				return error_line3;
+			}
+		}
 		return { };
 	}
 }
@@ -211,16 +270,23 @@ void RecordView::on_tick_second() {
 }
 
 void RecordView::update_status_display() {
+	/* Reserved but not yet written space is still available to the capture. */
+	File::Size reserved_unused = 0;
 	if( is_active() ) {
-		const auto dropped_percent = std::min(99U, capture_thread->state().dropped_percent());
+		const auto& state = capture_thread->state();
+		const auto dropped_percent = std::min(99U, state.dropped_percent());
 		const auto s = to_string_dec_uint(dropped_percent, 2, ' ') + "\%";
 		text_record_dropped.set(s);
+
+		const auto bytes_written = state.baseband_bytes_received - state.baseband_bytes_dropped;
+		reserved_unused = (reserved > bytes_written) ? (reserved - bytes_written) : 0;
 	}
 
 	if( sampling_rate ) {
 		const auto space_info = std::filesystem::space(u"");
-		const uint32_t bytes_per_second = file_type == FileType::WAV ? (sampling_rate * 2) : (sampling_rate * 4);
-		const uint32_t available_seconds = space_info.free / bytes_per_second;
+		/* Compressed captures are estimated at their uncompressed size. */
+		const uint32_t bytes_per_second = ((file_type == FileType::RawS16) || (file_type == FileType::RiceS16)) ? (sampling_rate * 4) : (sampling_rate * 2);
+		const uint32_t available_seconds = (space_info.free + reserved_unused) / bytes_per_second;
 		const uint32_t seconds = available_seconds % 60;
 		const uint32_t available_minutes = available_seconds / 60;
 		const uint32_t minutes = available_minutes % 60;
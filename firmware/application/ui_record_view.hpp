@@ -40,8 +40,11 @@ public:
 	std::function<void(std::string)> on_error { };
 
 	enum FileType {
+		RawS8 = 1,
 		RawS16 = 2,
 		WAV = 3,
+		/* Compressed S16, see baseband/iq_codec.hpp */
+		RiceS16 = 4,
 	};
 
 	RecordView(
@@ -56,6 +59,22 @@ public:
 	void focus() override;
 
 	void set_sampling_rate(const size_t new_sampling_rate);
+	void set_file_type(const FileType v);
+
+	/* Raw captures are written one file per segment, with an index.
+	 * For baseband captures that record only around activity.
+	 */
+	void set_segmented(const bool v);
+
+	/* Pre-trigger history actually kept ahead of each segment, recorded in
+	 * the metadata file of segmented captures.
+	 */
+	void set_pre_trigger_us(const uint32_t v);
+
+	/* Upper bound on the space reserved up front for a capture file, 0 for
+	 * none. Applies from the next capture started.
+	 */
+	void set_reserve_limit(const File::Size new_reserve_limit);
 
 	void start();
 	void stop();
@@ -64,7 +83,15 @@ public:
 	bool is_active() const;
 
 private:
+	/* Keeps start-up short: the FAT chain is written for the whole
+	 * reservation before streaming begins. Captures may grow past it.
+	 */
+	static constexpr File::Size reserve_limit_default = 1ULL << 30;
+	/* Left for other files written during a capture. */
+	static constexpr File::Size reserve_headroom = 4ULL << 20;
+
 	void toggle();
+	File::Size reserve_size() const;
 	Optional<File::Error> write_metadata_file(const std::filesystem::path& filename);
 
 	void on_tick_second();
@@ -74,10 +101,14 @@ private:
 	void handle_error(const File::Error error);
 
 	const std::filesystem::path filename_stem_pattern;
-	const FileType file_type;
+	FileType file_type;
+	bool segmented { false };
+	uint32_t pre_trigger_us { 0 };
 	const size_t write_size;
 	const size_t buffer_count;
 	size_t sampling_rate { 0 };
+	File::Size reserve_limit { reserve_limit_default };
+	File::Size reserved { 0 };
 	SignalToken signal_token_tick_second { };
 
 	Rectangle rect_background {
@@ -21,15 +21,16 @@
 
 #include "audio_compressor.hpp"
 
+#include <algorithm>
+
 float GainComputer::operator()(const float x) const {
 	const auto abs_x = std::abs(x);
 	const auto db = (abs_x < lin_floor) ? db_floor : log2_db_k * fast_log2(abs_x);
 	const auto overshoot_db = db - threshold_db;
 	if( knee_width_db > 0.0f ) {
-		const auto w2 = knee_width_db / 2.0f;
-		const auto a = w2 / (knee_width_db * knee_width_db);
-		const auto in_transition = (overshoot_db > -w2) && (overshoot_db < w2);
-		const auto rectified_overshoot = in_transition ? (a * std::pow(overshoot_db + w2, 2.0f)) : std::max(overshoot_db, 0.0f);
+		const auto in_transition = (overshoot_db > -knee_w2) && (overshoot_db < knee_w2);
+		const auto knee_x = overshoot_db + knee_w2;
+		const auto rectified_overshoot = in_transition ? (knee_a * knee_x * knee_x) : std::max(overshoot_db, 0.0f);
 		return rectified_overshoot * slope;
 	} else {
 		const auto rectified_overshoot = std::max(overshoot_db, 0.0f);
@@ -38,15 +39,109 @@ float GainComputer::operator()(const float x) const {
 }
 
 void FeedForwardCompressor::execute_in_place(const buffer_f32_t& buffer) {
-	constexpr float makeup_gain = std::pow(10.0f, (threshold - (threshold / ratio)) / -20.0f);
+	if( control_interval > 1 ) {
+		execute_block_rate(buffer);
+	} else {
+		execute_per_sample(buffer);
+	}
+}
+
+void FeedForwardCompressor::execute_per_sample(const buffer_f32_t& buffer) {
 	for(size_t i=0; i<buffer.count; i++) {
 		buffer.p[i] = execute_once(buffer.p[i]) * makeup_gain;
 	}
 }
 
+/* Inner loops of the block-rate path, unrolled by four. */
+
+static float peak_abs(const float* const p, const size_t n) {
+	float peak_0 = 0.0f;
+	float peak_1 = 0.0f;
+	size_t i = 0;
+	for(; (i + 4) <= n; i += 4) {
+		peak_0 = std::max(peak_0, std::max(std::abs(p[i + 0]), std::abs(p[i + 1])));
+		peak_1 = std::max(peak_1, std::max(std::abs(p[i + 2]), std::abs(p[i + 3])));
+	}
+	for(; i<n; i++) {
+		peak_0 = std::max(peak_0, std::abs(p[i]));
+	}
+	return std::max(peak_0, peak_1);
+}
+
+static void apply_gain_ramp(float* const p, const size_t n, float gain, const float gain_step) {
+	size_t i = 0;
+	for(; (i + 4) <= n; i += 4) {
+		gain += gain_step; p[i + 0] *= gain;
+		gain += gain_step; p[i + 1] *= gain;
+		gain += gain_step; p[i + 2] *= gain;
+		gain += gain_step; p[i + 3] *= gain;
+	}
+	for(; i<n; i++) {
+		gain += gain_step; p[i] *= gain;
+	}
+}
+
+static float peak_abs_and_scale(float* const p, const size_t n, const float gain) {
+	float peak_0 = 0.0f;
+	float peak_1 = 0.0f;
+	size_t i = 0;
+	for(; (i + 4) <= n; i += 4) {
+		const auto x0 = p[i + 0];
+		const auto x1 = p[i + 1];
+		const auto x2 = p[i + 2];
+		const auto x3 = p[i + 3];
+		peak_0 = std::max(peak_0, std::max(std::abs(x0), std::abs(x1)));
+		peak_1 = std::max(peak_1, std::max(std::abs(x2), std::abs(x3)));
+		p[i + 0] = x0 * gain;
+		p[i + 1] = x1 * gain;
+		p[i + 2] = x2 * gain;
+		p[i + 3] = x3 * gain;
+	}
+	for(; i<n; i++) {
+		peak_0 = std::max(peak_0, std::abs(p[i]));
+		p[i] *= gain;
+	}
+	return std::max(peak_0, peak_1);
+}
+
+void FeedForwardCompressor::execute_block_rate(const buffer_f32_t& buffer) {
+	/* Control intervals may span buffers: the running peak and sample count
+	 * carry over, so the control rate doesn't depend on the buffer size.
+	 */
+	auto p = buffer.p;
+	const auto end = &buffer.p[buffer.count];
+	while(p < end) {
+		const size_t n = std::min(control_interval - interval_count, static_cast<size_t>(end - p));
+
+		interval_count += n;
+
+		if( interval_count < control_interval ) {
+			/* Interval continues in the next buffer, hold the current gain. */
+			interval_peak = std::max(interval_peak, peak_abs_and_scale(p, n, gain_last));
+		} else {
+			interval_peak = std::max(interval_peak, peak_abs(p, n));
+			const auto gain_next = compute_gain(interval_peak) * makeup_gain;
+			if( gain_next < gain_last ) {
+				/* Attack: the envelope already covers these samples. */
+				apply_gain_ramp(p, n, gain_next, 0.0f);
+			} else {
+				apply_gain_ramp(p, n, gain_last, (gain_next - gain_last) / n);
+			}
+			gain_last = gain_next;
+			interval_peak = 0.0f;
+			interval_count = 0;
+		}
+
+		p += n;
+	}
+}
+
 float FeedForwardCompressor::execute_once(const float x) {
-	const auto gain_db = gain_computer(x);
+	return x * compute_gain(x);
+}
+
+float FeedForwardCompressor::compute_gain(const float envelope) {
+	const auto gain_db = gain_computer(envelope);
 	const auto peak_db = -peak_detector(-gain_db);
-	const auto gain = fast_pow2(peak_db * (3.321928094887362f / 20.0f));
-	return x * gain;
+	return fast_pow2(peak_db * (3.321928094887362f / 20.0f));
 }
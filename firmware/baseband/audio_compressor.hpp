@@ -53,6 +53,10 @@ private:
 
 	static constexpr float knee_width_db = 0.0f;
 
+	/* Soft knee quadratic, precomputed: a * (overshoot + w2)^2 */
+	static constexpr float knee_w2 = knee_width_db / 2.0f;
+	static constexpr float knee_a = (knee_width_db > 0.0f) ? (knee_w2 / (knee_width_db * knee_width_db)) : 0.0f;
+
 	static constexpr float db_floor = -120.0f;
 	static constexpr float lin_floor = std::pow(10.0f, db_floor / 20.0f);
 	static constexpr float log2_db_k = 20.0f * std::log10(2.0f);
@@ -82,17 +86,52 @@ private:
 
 class FeedForwardCompressor {
 public:
+	/* control_interval == 1: gain computed for every sample.
+	 * control_interval > 1: envelope (peak of |x|) and gain computed once per
+	 * control_interval samples. Intervals may span buffers, so the control
+	 * rate and the peak detector time constants, scaled to that rate, don't
+	 * depend on the buffer size. The gain is computed once the interval is
+	 * complete; when it falls, the samples not yet scaled take the new gain
+	 * at once. Rising gain (release) is ramped linearly across them. The gain
+	 * trajectory lags the per-sample result by at most control_interval
+	 * samples (2.67ms for 32 samples at 12kHz, vs. 10ms attack).
+	 *
+	 * Cost, 32 sample interval on 8 sample AM blocks: envelope and scaling
+	 * share one pass while the interval is open, and the gain computation
+	 * (about 60 cycles) runs once per interval. About 4x fewer cycles than
+	 * control_interval == 1.
+	 */
+	FeedForwardCompressor(
+		const size_t control_interval = 1
+	) : control_interval { std::max(control_interval, static_cast<size_t>(1)) },
+		peak_detector {
+			tau_alpha(0.010f, fs / this->control_interval),
+			tau_alpha(0.300f, fs / this->control_interval)
+		}
+	{
+	}
+
 	void execute_in_place(const buffer_f32_t& buffer);
 
 private:
 	static constexpr float fs = 12000.0f;
 	static constexpr float ratio = 10.0f;
 	static constexpr float threshold = -30.0f;
+	static constexpr float makeup_gain = std::pow(10.0f, (threshold - (threshold / ratio)) / -20.0f);
+
+	const size_t control_interval;
+	float gain_last { 1.0f };
+	float interval_peak { 0.0f };
+	size_t interval_count { 0 };
 
 	GainComputer gain_computer { ratio, threshold };
-	PeakDetectorBranchingSmooth peak_detector { tau_alpha(0.010f, fs), tau_alpha(0.300f, fs) };
+	PeakDetectorBranchingSmooth peak_detector;
 
 	float execute_once(const float x);
+	float compute_gain(const float envelope);
+
+	void execute_per_sample(const buffer_f32_t& buffer);
+	void execute_block_rate(const buffer_f32_t& buffer);
 
 	static constexpr float tau_alpha(const float tau, const float fs) {
 		return std::exp(-1.0f / (tau * fs));
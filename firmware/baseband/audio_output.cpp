@@ -31,6 +31,9 @@
 #include <cstddef>
 #include <array>
 
+uint32_t AudioOutput::channel_blocks_count = 0;
+uint32_t AudioOutput::channel_idle_blocks_count = 0;
+
 void AudioOutput::configure(
 	const iir_biquad_config_t& hpf_config,
 	const iir_biquad_config_t& deemph_config,
@@ -38,6 +41,8 @@ void AudioOutput::configure(
 ) {
 	hpf.configure(hpf_config);
 	deemph.configure(deemph_config);
+	hpf_right.configure(hpf_config);
+	deemph_right.configure(deemph_config);
 	squelch.set_threshold(squelch_threshold);
 }
 
@@ -66,6 +71,75 @@ void AudioOutput::write(
 	);
 }
 
+void AudioOutput::write(
+	const buffer_s16_t& left,
+	const buffer_s16_t& right
+) {
+	std::array<float, 32> left_f;
+	std::array<float, 32> right_f;
+	for(size_t i=0; i<left.count; i++) {
+		left_f[i] = left.p[i] * ki;
+		right_f[i] = right.p[i] * ki;
+	}
+	const buffer_f32_t left_buffer { left_f.data(), left.count, left.sampling_rate };
+	const buffer_f32_t right_buffer { right_f.data(), right.count, right.sampling_rate };
+
+	hpf.execute_in_place(left_buffer);
+	hpf_right.execute_in_place(right_buffer);
+	deemph.execute_in_place(left_buffer);
+	deemph_right.execute_in_place(right_buffer);
+
+	fill_audio_buffer(left_buffer, right_buffer);
+}
+
+void AudioOutput::write_silence(
+	const size_t count,
+	const uint32_t sampling_rate
+) {
+	std::array<float, 32> silence { };
+	block_buffer.feed(
+		{ silence.data(), count, sampling_rate },
+		[this](const buffer_f32_t& buffer) {
+			this->on_block_silence(buffer);
+		}
+	);
+}
+
+bool AudioOutput::is_channel_idle(const buffer_c16_t& channel) {
+	channel_blocks_count++;
+
+	if( !is_squelched() ) {
+		return false;
+	}
+
+	if( !idle ) {
+		/* Squelch just saw a full hang period of noise, so the detector's
+		 * first window seeds the floor.
+		 */
+		activity_detector.reset();
+		idle = true;
+	}
+
+	if( activity_detector.execute(channel) ) {
+		resume();
+		idle = false;
+		return false;
+	}
+
+	channel_idle_blocks_count++;
+	return true;
+}
+
+/* Restart audio processing after idle, warming up filter state first. */
+void AudioOutput::resume() {
+	hpf.reset();
+	deemph.reset();
+	squelch.reset();
+	audio_present_history = 0;
+	squelch_closed_blocks = 0;
+	warmup_blocks_remaining = warmup_blocks;
+}
+
 void AudioOutput::on_block(
 	const buffer_f32_t& audio
 ) {
@@ -74,8 +148,21 @@ void AudioOutput::on_block(
 	hpf.execute_in_place(audio);
 	deemph.execute_in_place(audio);
 
+	if( warmup_blocks_remaining ) {
+		/* Filters are settling from reset state, keep output muted. */
+		warmup_blocks_remaining--;
+		on_block_silence(audio);
+		return;
+	}
+
 	audio_present_history = (audio_present_history << 1) | (audio_present_now ? 1 : 0);
 	const bool audio_present = (audio_present_history != 0);
+
+	if( audio_present ) {
+		squelch_closed_blocks = 0;
+	} else if( squelch_closed_blocks < squelch_hang_blocks ) {
+		squelch_closed_blocks++;
+	}
 	
 	if( !audio_present ) {
 		for(size_t i=0; i<audio.count; i++) {
@@ -103,6 +190,43 @@ void AudioOutput::fill_audio_buffer(const buffer_f32_t& audio, const bool send_t
 	feed_audio_stats(audio);
 }
 
+void AudioOutput::fill_audio_buffer(const buffer_f32_t& left, const buffer_f32_t& right) {
+	std::array<int16_t, 32> audio_int;
+	std::array<float, 32> audio_mono;
+
+	auto audio_buffer = audio::dma::tx_empty_buffer();
+	for(size_t i=0; i<audio_buffer.count; i++) {
+		const int32_t left_int = left.p[i] * k;
+		const int32_t right_int = right.p[i] * k;
+		audio_buffer.p[i].left = __SSAT(left_int, 16);
+		audio_buffer.p[i].right = __SSAT(right_int, 16);
+		audio_mono[i] = (left.p[i] + right.p[i]) * 0.5f;
+		const int32_t mono_int = audio_mono[i] * k;
+		audio_int[i] = __SSAT(mono_int, 16);
+	}
+	if( stream ) {
+		stream->write(audio_int.data(), audio_buffer.count * sizeof(audio_int[0]));
+	}
+
+	feed_audio_stats({ audio_mono.data(), audio_buffer.count, left.sampling_rate });
+}
+
+void AudioOutput::on_block_silence(const buffer_f32_t& audio) {
+	auto audio_buffer = audio::dma::tx_empty_buffer();
+	for(size_t i=0; i<audio_buffer.count; i++) {
+		audio_buffer.p[i].raw = 0;
+	}
+
+	audio_stats.mute(
+		audio.count,
+		audio.sampling_rate,
+		[](const AudioStatistics& statistics) {
+			const AudioStatisticsMessage audio_stats_message { statistics };
+			shared_memory.application_queue.push(audio_stats_message);
+		}
+	);
+}
+
 void AudioOutput::feed_audio_stats(const buffer_f32_t& audio) {
 	audio_stats.feed(
 		audio,
@@ -45,6 +45,32 @@ public:
 	void write(const buffer_s16_t& audio);
 	void write(const buffer_f32_t& audio);
 
+	/* Stereo output. Blocks must match the audio DMA transfer size. No squelch
+	 * is applied. Stream (if any) receives the mono mix.
+	 */
+	void write(const buffer_s16_t& left, const buffer_s16_t& right);
+
+	/* Fill audio output with silence without running any audio processing.
+	 * Used by demodulators while squelch is closed.
+	 */
+	void write_silence(const size_t count, const uint32_t sampling_rate);
+
+	/* Once squelch has been closed for a full hang period, only the channel
+	 * activity detector runs and this returns true. Callers then skip
+	 * demodulation and write silence. Audio processing restarts, with filter
+	 * warm-up, when the detector sees activity.
+	 */
+	bool is_channel_idle(const buffer_c16_t& channel);
+
+	/* Blocks checked by is_channel_idle() and how many of them were idle. */
+	static uint32_t channel_blocks() {
+		return channel_blocks_count;
+	}
+
+	static uint32_t channel_idle_blocks() {
+		return channel_idle_blocks_count;
+	}
+
 	void set_stream(std::unique_ptr<StreamInput> new_stream) {
 		stream = std::move(new_stream);
 	}
@@ -53,20 +79,40 @@ private:
 	static constexpr float k = 32768.0f;
 	static constexpr float ki = 1.0f / k;
 
+	static constexpr size_t squelch_hang_blocks = 64;
+	static constexpr size_t warmup_blocks = 2;
+
 	BlockDecimator<float, 32> block_buffer { 1 };	
 
 	IIRBiquadFilter hpf { };
 	IIRBiquadFilter deemph { };
+	IIRBiquadFilter hpf_right { };
+	IIRBiquadFilter deemph_right { };
 	FMSquelch squelch { };
+	ChannelActivityDetector activity_detector { };
 
 	std::unique_ptr<StreamInput> stream { };
 
 	AudioStatsCollector audio_stats { };
 
 	uint64_t audio_present_history = 0;
+	size_t squelch_closed_blocks = 0;
+	size_t warmup_blocks_remaining = 0;
+	bool idle = false;
+
+	static uint32_t channel_blocks_count;
+	static uint32_t channel_idle_blocks_count;
+
+	bool is_squelched() const {
+		return squelch_closed_blocks >= squelch_hang_blocks;
+	}
+
+	void resume();
 
 	void on_block(const buffer_f32_t& audio);
+	void on_block_silence(const buffer_f32_t& audio);
 	void fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo);
+	void fill_audio_buffer(const buffer_f32_t& left, const buffer_f32_t& right);
 	void feed_audio_stats(const buffer_f32_t& audio);
 };
 
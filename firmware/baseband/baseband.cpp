@@ -79,7 +79,8 @@ void _default_exit(void) {
 	ShutdownMessage shutdown_message;
 	shared_memory.application_queue.push(shutdown_message);
 
-	shared_memory.baseband_message = nullptr;
+	__DMB();
+	shared_memory.baseband_completed = shared_memory.baseband_completed + 1;
 
 	halt();
 }
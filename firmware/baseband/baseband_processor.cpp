@@ -25,8 +25,8 @@
 
 #include "message.hpp"
 
-void BasebandProcessor::feed_channel_stats(const buffer_c16_t& channel) {
-	channel_stats.feed(
+uint32_t BasebandProcessor::feed_channel_stats(const buffer_c16_t& channel) {
+	return channel_stats.feed(
 		channel,
 		[](const ChannelStatistics& statistics) {
 			const ChannelStatisticsMessage channel_stats_message { statistics };
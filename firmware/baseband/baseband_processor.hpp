@@ -37,7 +37,8 @@ public:
 	virtual void on_message(const Message* const) { };
 
 protected:
-	void feed_channel_stats(const buffer_c16_t& channel);
+	/* Returns the channel's peak magnitude squared. */
+	uint32_t feed_channel_stats(const buffer_c16_t& channel);
 
 private:
 	ChannelStatsCollector channel_stats { };
@@ -21,6 +21,9 @@
 
 #include "baseband_stats_collector.hpp"
 
+#include "event_moderator.hpp"
+#include "audio_output.hpp"
+
 #include "lpc43xx_cpp.hpp"
 
 bool BasebandStatsCollector::process(const buffer_c8_t& buffer) {
@@ -50,6 +53,22 @@ BasebandStatistics BasebandStatsCollector::capture_statistics() {
 	statistics.baseband_ticks = (baseband_ticks - last_baseband_ticks);
 	last_baseband_ticks = baseband_ticks;
 
+	const auto events_requested = m4_event_moderator.requests();
+	statistics.events_requested = (events_requested - last_events_requested);
+	last_events_requested = events_requested;
+
+	const auto events_signalled = m4_event_moderator.signals();
+	statistics.events_signalled = (events_signalled - last_events_signalled);
+	last_events_signalled = events_signalled;
+
+	const auto channel_blocks = AudioOutput::channel_blocks();
+	statistics.channel_blocks = (channel_blocks - last_channel_blocks);
+	last_channel_blocks = channel_blocks;
+
+	const auto channel_idle_blocks = AudioOutput::channel_idle_blocks();
+	statistics.channel_idle_blocks = (channel_idle_blocks - last_channel_idle_blocks);
+	last_channel_idle_blocks = channel_idle_blocks;
+
 	statistics.saturation = lpc43xx::m4::flag_saturation();
 	lpc43xx::m4::clear_flag_saturation();
 
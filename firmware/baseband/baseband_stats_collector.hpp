@@ -63,6 +63,10 @@ private:
 	uint32_t last_rssi_ticks { 0 };
 	const Thread* const thread_baseband;
 	uint32_t last_baseband_ticks { 0 };
+	uint32_t last_events_requested { 0 };
+	uint32_t last_events_signalled { 0 };
+	uint32_t last_channel_blocks { 0 };
+	uint32_t last_channel_idle_blocks { 0 };
 
 	bool process(const buffer_c8_t& buffer);
 	BasebandStatistics capture_statistics();
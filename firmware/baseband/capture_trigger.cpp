@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "capture_trigger.hpp"
+
+#include "utility.hpp"
+
+#include <algorithm>
+
+CaptureTrigger::CaptureTrigger(
+	const int32_t threshold_db,
+	const size_t history_chunks,
+	const size_t hold_chunks
+) : threshold_db { threshold_db },
+	history_chunks { std::min(history_chunks, history_chunks_max) },
+	hold_chunks { std::max(hold_chunks, size_t { 1 }) }
+{
+}
+
+void CaptureTrigger::feed(
+	StreamInput& stream,
+	const void* const data,
+	const size_t length,
+	const uint32_t peak_mag_sq
+) {
+	const int32_t peak_db = mag2_to_dbv_norm(peak_mag_sq * (1.0f / (32768.0f * 32768.0f)));
+
+	if( peak_db >= threshold_db ) {
+		if( hold_remaining == 0 ) {
+			stream.release_history(history_length);
+			history_clear();
+		}
+		hold_remaining = hold_chunks;
+		stream.write(data, length);
+	} else if( hold_remaining ) {
+		stream.write(data, length);
+		if( --hold_remaining == 0 ) {
+			stream.end_segment();
+		}
+	} else {
+		stream.hold_history();
+		if( stream.write(data, length) == length ) {
+			history_push(length, stream.history_size());
+		} else {
+			/* The history must be contiguous, restart it after the gap. */
+			history_clear();
+		}
+	}
+}
+
+void CaptureTrigger::reset() {
+	history_clear();
+	hold_remaining = 0;
+}
+
+void CaptureTrigger::stop(StreamInput& stream) {
+	if( hold_remaining ) {
+		stream.end_segment();
+	} else {
+		stream.release_history(0);
+	}
+	reset();
+}
+
+void CaptureTrigger::history_push(const size_t length, const size_t history_size) {
+	if( history_chunks == 0 ) {
+		return;
+	}
+
+	if( chunk_count == history_chunks ) {
+		history_pop();
+	}
+
+	chunk_length[(chunk_first + chunk_count) % chunk_length.size()] = length;
+	chunk_count++;
+	history_length += length;
+
+	/* Only chunks the stream still holds in full count. */
+	while( history_length > history_size ) {
+		history_pop();
+	}
+}
+
+void CaptureTrigger::history_pop() {
+	history_length -= chunk_length[chunk_first];
+	chunk_first = (chunk_first + 1) % chunk_length.size();
+	chunk_count--;
+}
+
+void CaptureTrigger::history_clear() {
+	chunk_first = 0;
+	chunk_count = 0;
+	history_length = 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __CAPTURE_TRIGGER_H__
+#define __CAPTURE_TRIGGER_H__
+
+#include "stream_input.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* Passes capture data to the stream only around activity. While idle, the
+ * stream holds the most recent chunks back as history, in its own buffers.
+ * When a chunk's channel peak reaches the threshold, the history is handed
+ * over ahead of it, and streaming continues until the channel has been quiet
+ * for hold_chunks. Each such run ends with a segment end marker.
+ *
+ * Chunks are kept or discarded whole, so compressed blocks stay intact.
+ */
+class CaptureTrigger {
+public:
+	CaptureTrigger(
+		const int32_t threshold_db,
+		const size_t history_chunks,
+		const size_t hold_chunks
+	);
+
+	CaptureTrigger(const CaptureTrigger&) = delete;
+	CaptureTrigger(CaptureTrigger&&) = delete;
+	CaptureTrigger& operator=(const CaptureTrigger&) = delete;
+	CaptureTrigger& operator=(CaptureTrigger&&) = delete;
+
+	/* Deepest history kept, in chunks. It may be less for large chunks. */
+	static constexpr size_t history_chunks_max = 64;
+
+	void feed(
+		StreamInput& stream,
+		const void* const data,
+		const size_t length,
+		const uint32_t peak_mag_sq
+	);
+
+	/* Forgets the history and any segment in progress, for a new stream. */
+	void reset();
+
+	/* Ends any segment in progress and drops the history, leaving the
+	 * stream to pass all data through.
+	 */
+	void stop(StreamInput& stream);
+
+private:
+	/* Lengths of the chunks in the stream's history, oldest first. */
+	std::array<uint16_t, history_chunks_max> chunk_length { };
+	size_t chunk_first { 0 };
+	size_t chunk_count { 0 };
+	size_t history_length { 0 };
+
+	const int32_t threshold_db;
+	const size_t history_chunks;
+	const size_t hold_chunks;
+	size_t hold_remaining { 0 };
+
+	void history_push(const size_t length, const size_t history_size);
+	void history_pop();
+	void history_clear();
+};
+
+#endif/*__CAPTURE_TRIGGER_H__*/
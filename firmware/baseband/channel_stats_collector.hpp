@@ -33,9 +33,13 @@
 
 class ChannelStatsCollector {
 public:
+	/* Returns the peak magnitude squared of src alone. */
 	template<typename Callback>
-	void feed(const buffer_c16_t& src, Callback callback) {
-		max_squared = compute_max_squared(src, max_squared); 
+	uint32_t feed(const buffer_c16_t& src, Callback callback) {
+		const auto src_max_squared = compute_max_squared(src, 0);
+		if( src_max_squared > max_squared ) {
+			max_squared = src_max_squared;
+		}
 		count += src.count;
 
 		const size_t samples_per_update = src.sampling_rate * update_interval;
@@ -48,6 +52,8 @@ public:
 			max_squared = 0;
 			count = 0;
 		}
+
+		return src_max_squared;
 	}
 
 private:
@@ -22,6 +22,7 @@
 #ifndef __CLOCK_RECOVERY_H__
 #define __CLOCK_RECOVERY_H__
 
+#include <cstdint>
 #include <cstddef>
 #include <array>
 #include <functional>
@@ -180,6 +181,300 @@ private:
 	}
 };
 
+/* Fixed-point symbol timing recovery ************************************/
+
+/* Samples are int32_t, expected within int16_t range. Interpolation phase
+ * (mu) is Q16, in fractions of an input sample.
+ */
+
+class LinearInterpolator {
+public:
+	static constexpr size_t length { 2 };
+	static constexpr size_t delay { 1 };
+
+	void push(const int32_t sample) {
+		x0 = x1;
+		x1 = sample;
+	}
+
+	/* Interpolate between the previous and latest sample. */
+	int32_t operator()(const int32_t mu) const {
+		return x0 + static_cast<int32_t>((static_cast<int64_t>(x1 - x0) * mu) >> 16);
+	}
+
+private:
+	int32_t x0 { 0 };
+	int32_t x1 { 0 };
+};
+
+/* Cubic Lagrange interpolator in Farrow form. Interpolates between the two
+ * middle samples of the last four, so adds one sample of delay.
+ */
+class CubicInterpolator {
+public:
+	static constexpr size_t length { 4 };
+	static constexpr size_t delay { 2 };
+
+	void push(const int32_t sample) {
+		xm1 = x0;
+		x0 = x1;
+		x1 = x2;
+		x2 = sample;
+
+		/* Farrow coefficients, scaled by 6 to keep them integer. */
+		c3 = (x2 - xm1) + 3 * (x0 - x1);
+		c2 = 3 * (x1 + xm1) - 6 * x0;
+		c1 = 6 * x1 - 3 * x0 - 2 * xm1 - x2;
+	}
+
+	int32_t operator()(const int32_t mu) const {
+		int64_t v = c3;
+		v = ((v * mu) >> 16) + c2;
+		v = ((v * mu) >> 16) + c1;
+		v = ((v * mu) >> 16);
+		return x0 + static_cast<int32_t>(v / 6);
+	}
+
+private:
+	int32_t xm1 { 0 };
+	int32_t x0 { 0 };
+	int32_t x1 { 0 };
+	int32_t x2 { 0 };
+	int32_t c3 { 0 };
+	int32_t c2 { 0 };
+	int32_t c1 { 0 };
+};
+
+/* Tracks mean symbol magnitude, for normalizing timing error. */
+class SymbolAmplitude {
+public:
+	void update(const int32_t symbol) {
+		const int32_t magnitude = (symbol < 0) ? -symbol : symbol;
+		value_ += (magnitude - value_) >> 3;
+	}
+
+	int32_t value() const {
+		return (value_ > 0) ? value_ : 1;
+	}
+
+	void reset(const int32_t symbol) {
+		value_ = (symbol < 0) ? -symbol : symbol;
+	}
+
+private:
+	int32_t value_ { 0 };
+};
+
+inline int32_t normalize_timing_error(const int64_t error, const int64_t scale) {
+	/* Limit to +/-2.0 (Q16). */
+	const int64_t limit = 2 << 16;
+	const int64_t result = (error << 16) / scale;
+	return (result > limit) ? limit : ((result < -limit) ? -limit : result);
+}
+
+/* Two samples per symbol. Error is positive when sampling late. */
+class GardnerDetector {
+public:
+	static constexpr size_t samples_per_symbol { 2 };
+	/* Mean error per symbol period of timing offset, for random binary
+	 * symbols through a rectangular matched filter.
+	 */
+	static constexpr float gain { 0.75f };
+
+	template<typename SymbolHandler>
+	void operator()(
+		const int32_t in,
+		SymbolHandler symbol_handler
+	) {
+		t2 = t1;
+		t1 = t0;
+		t0 = in;
+
+		if( symbol_phase == 0 ) {
+			amplitude.update(t0);
+			const int32_t a = amplitude.value();
+			const int64_t lateness = static_cast<int64_t>(t0 - t2) * t1;
+			symbol_handler(t0, normalize_timing_error(lateness, static_cast<int64_t>(a) * a * 2));
+		}
+
+		symbol_phase ^= 1;
+	}
+
+	/* Next input is the sample midway after last_symbol. */
+	void align(const int32_t last_symbol) {
+		t0 = last_symbol;
+		symbol_phase = 1;
+		amplitude.reset(last_symbol);
+	}
+
+private:
+	int32_t t0 { 0 };
+	int32_t t1 { 0 };
+	int32_t t2 { 0 };
+	size_t symbol_phase { 0 };
+	SymbolAmplitude amplitude { };
+};
+
+/* Decision-directed, one sample per symbol, binary symbols. Error is
+ * positive when sampling late.
+ */
+class MuellerMullerDetector {
+public:
+	static constexpr size_t samples_per_symbol { 1 };
+	static constexpr float gain { 0.55f };
+
+	template<typename SymbolHandler>
+	void operator()(
+		const int32_t in,
+		SymbolHandler symbol_handler
+	) {
+		amplitude.update(in);
+		const int32_t d = (in >= 0) ? 1 : -1;
+		const int32_t lateness = d * x_last - d_last * in;
+		x_last = in;
+		d_last = d;
+		symbol_handler(in, normalize_timing_error(lateness, amplitude.value() * 2));
+	}
+
+	/* Next input is the symbol after last_symbol. */
+	void align(const int32_t last_symbol) {
+		x_last = last_symbol;
+		d_last = (last_symbol >= 0) ? 1 : -1;
+		amplitude.reset(last_symbol);
+	}
+
+private:
+	int32_t x_last { 0 };
+	int32_t d_last { 1 };
+	SymbolAmplitude amplitude { };
+};
+
+/* Proportional-integral loop filter, updated once per symbol. Input is
+ * timing error (Q16), output is timing correction in symbols (Q16).
+ */
+class PILoopFilter {
+public:
+	/* loop_bandwidth is normalized to the symbol rate (BnT). */
+	void configure(
+		const float loop_bandwidth,
+		const float damping,
+		const float detector_gain
+	) {
+		const float theta = loop_bandwidth / (damping + 0.25f / damping);
+		const float d = 1.0f + 2.0f * damping * theta + theta * theta;
+		kp = (4.0f * damping * theta / d) / detector_gain * 65536.0f;
+		ki = (4.0f * theta * theta / d) / detector_gain * 65536.0f;
+		integrator = 0;
+	}
+
+	void reset() {
+		integrator = 0;
+	}
+
+	int32_t operator()(const int32_t error) {
+		integrator += (static_cast<int64_t>(ki) * error) >> 16;
+		if( integrator > integrator_limit ) {
+			integrator = integrator_limit;
+		}
+		if( integrator < -integrator_limit ) {
+			integrator = -integrator_limit;
+		}
+		return static_cast<int32_t>((static_cast<int64_t>(kp) * error) >> 16) + integrator;
+	}
+
+private:
+	/* Symbol rate error of +/-2%. */
+	static constexpr int32_t integrator_limit = 65536 / 50;
+
+	int32_t kp { 0 };
+	int32_t ki { 0 };
+	int32_t integrator { 0 };
+};
+
+/* Symbol timing recovery in fixed point: Q16 phase accumulator driving an
+ * interpolator, a timing error detector and a PI loop filter. Symbol
+ * handlers are passed per call so they can be inlined.
+ */
+template<typename Interpolator, typename ErrorDetector>
+class FixedPointClockRecovery {
+public:
+	/* Samples needed to fill interpolator history, see skip(). */
+	static constexpr size_t history_length { Interpolator::length };
+
+	FixedPointClockRecovery(
+		const float sampling_rate,
+		const float symbol_rate,
+		const float loop_bandwidth,
+		const float damping = 0.707f
+	) {
+		configure(sampling_rate, symbol_rate, loop_bandwidth, damping);
+	}
+
+	FixedPointClockRecovery() = default;
+
+	void configure(
+		const float sampling_rate,
+		const float symbol_rate,
+		const float loop_bandwidth,
+		const float damping = 0.707f
+	) {
+		const float output_rate = symbol_rate * ErrorDetector::samples_per_symbol;
+		phase_increment = sampling_rate / output_rate * 65536.0f;
+		samples_per_symbol = sampling_rate / symbol_rate * 65536.0f;
+		phase = 0;
+		loop_filter.configure(loop_bandwidth, damping, ErrorDetector::gain);
+	}
+
+	template<typename SymbolHandler>
+	void operator()(
+		const int32_t sample,
+		SymbolHandler symbol_handler
+	) {
+		interpolator.push(sample);
+		while( phase < (1 << 16) ) {
+			const auto interpolated = interpolator(phase);
+			phase += phase_increment;
+			timing_error_detector(interpolated,
+				[this, &symbol_handler](const int32_t symbol, const int32_t lateness) {
+					symbol_handler(symbol);
+					this->adjust(loop_filter(lateness));
+				}
+			);
+		}
+		phase -= (1 << 16);
+	}
+
+	/* Keep interpolator history current without producing symbols. */
+	void skip(const int32_t sample) {
+		interpolator.push(sample);
+	}
+
+	/* Restart timing from a known symbol: symbol_offset is its center
+	 * relative to the most recently pushed sample (Q16 samples, <= 0).
+	 */
+	void align(const int32_t symbol_offset, const int32_t symbol) {
+		phase = symbol_offset + (static_cast<int32_t>(Interpolator::delay - 1) << 16) + phase_increment;
+		timing_error_detector.align(symbol);
+		loop_filter.reset();
+	}
+
+private:
+	Interpolator interpolator { };
+	ErrorDetector timing_error_detector { };
+	PILoopFilter loop_filter { };
+	int32_t phase { 0 };
+	int32_t phase_increment { 1 << 16 };
+	int32_t samples_per_symbol { 1 << 16 };
+
+	void adjust(const int32_t correction_symbols) {
+		/* Late: sample sooner. Limit to half an output sample per symbol. */
+		const int32_t limit = phase_increment / 2;
+		int32_t correction = (static_cast<int64_t>(correction_symbols) * samples_per_symbol) >> 16;
+		correction = (correction > limit) ? limit : ((correction < -limit) ? -limit : correction);
+		phase -= correction;
+	}
+};
+
 } /* namespace clock_recovery */
 
 #endif/*__CLOCK_RECOVERY_H__*/
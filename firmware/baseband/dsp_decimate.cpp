@@ -645,6 +645,61 @@ buffer_s16_t FIR64AndDecimateBy2Real::execute(
 	return { dst.p, src.count / 2, src.sampling_rate / 2 };
 }
 
+void FIR64AndDecimateBy2RealDual::configure(
+	const std::array<int16_t, taps_count>& new_taps
+) {
+	std::copy(new_taps.cbegin(), new_taps.cend(), taps.begin());
+}
+
+size_t FIR64AndDecimateBy2RealDual::execute(
+	const buffer_s16_t& src_a,
+	const buffer_s16_t& src_b,
+	const buffer_s16_t& dst_a,
+	const buffer_s16_t& dst_b
+) {
+	/* int16_t input (sample count "n" must be multiple of 2)
+	 * -> int16_t output, decimated by 2.
+	 * taps are normalized to 1 << 16 == 1.0.
+	 */
+	const size_t n = std::min(src_a.count, block_size_max);
+	std::copy(&src_a.p[0], &src_a.p[n], &z_a[history_count]);
+	std::copy(&src_b.p[0], &src_b.p[n], &z_b[history_count]);
+
+	const uint32_t* const taps_w = reinterpret_cast<const uint32_t*>(taps.data());
+	const uint32_t* za_w = reinterpret_cast<const uint32_t*>(z_a.data());
+	const uint32_t* zb_w = reinterpret_cast<const uint32_t*>(z_b.data());
+	auto dst_a_p = dst_a.p;
+	auto dst_b_p = dst_b.p;
+	for(size_t i=0; i<n; i+=2) {
+		int32_t t_a = 0;
+		int32_t t_b = 0;
+		for(size_t j=0; j<taps_count/2; j+=4) {
+			const uint32_t tap0 = taps_w[j+0];
+			const uint32_t tap1 = taps_w[j+1];
+			const uint32_t tap2 = taps_w[j+2];
+			const uint32_t tap3 = taps_w[j+3];
+			t_a = __SMLAD(za_w[j+0], tap0, t_a);
+			t_b = __SMLAD(zb_w[j+0], tap0, t_b);
+			t_a = __SMLAD(za_w[j+1], tap1, t_a);
+			t_b = __SMLAD(zb_w[j+1], tap1, t_b);
+			t_a = __SMLAD(za_w[j+2], tap2, t_a);
+			t_b = __SMLAD(zb_w[j+2], tap2, t_b);
+			t_a = __SMLAD(za_w[j+3], tap3, t_a);
+			t_b = __SMLAD(zb_w[j+3], tap3, t_b);
+		}
+		*(dst_a_p++) = t_a / 65536;
+		*(dst_b_p++) = t_b / 65536;
+
+		za_w++;
+		zb_w++;
+	}
+
+	std::copy(&z_a[n], &z_a[n + history_count], &z_a[0]);
+	std::copy(&z_b[n], &z_b[n + history_count], &z_b[0]);
+
+	return n / 2;
+}
+
 void FIRAndDecimateComplex::configure_common(
 	const size_t taps_count, const size_t decimation_factor
 ) {
@@ -90,6 +90,37 @@ private:
 	std::array<int16_t, taps_count> taps { };
 };
 
+/* Two real channels through the same 64-tap filter. Tap pairs are loaded once
+ * and applied to both channels with dual 16-bit MACs. Delay lines are kept
+ * word-aligned, which holds because decimation by 2 advances by one word.
+ */
+class FIR64AndDecimateBy2RealDual {
+public:
+	static constexpr size_t taps_count = 64;
+	static constexpr size_t block_size_max = 64;
+
+	void configure(
+		const std::array<int16_t, taps_count>& taps
+	);
+
+	/* src_a.count == src_b.count, must be a multiple of 2, and <= block_size_max.
+	 * Returns output sample count (per channel).
+	 */
+	size_t execute(
+		const buffer_s16_t& src_a,
+		const buffer_s16_t& src_b,
+		const buffer_s16_t& dst_a,
+		const buffer_s16_t& dst_b
+	);
+
+private:
+	static constexpr size_t history_count = taps_count - 2;
+
+	alignas(4) std::array<int16_t, history_count + block_size_max> z_a { };
+	alignas(4) std::array<int16_t, history_count + block_size_max> z_b { };
+	alignas(4) std::array<int16_t, taps_count> taps { };
+};
+
 class FIRC8xR16x24FS4Decim4 {
 public:
 	static constexpr size_t taps_count = 24;
@@ -217,6 +248,17 @@ public:
 		configure(taps.data(), taps.size(), decimation_factor);
 	}
 
+	/* taps_count must be a multiple of 8. */
+	template<typename T>
+	void configure(
+		const T* const taps,
+		const size_t taps_count,
+		const size_t decimation_factor
+	) {
+		configure_common(taps_count, decimation_factor);
+		std::reverse_copy(&taps[0], &taps[taps_count], &taps_reversed_[0]);
+	}
+
 	buffer_c16_t execute(
 		const buffer_c16_t& src,
 		const buffer_c16_t& dst
@@ -230,16 +272,6 @@ private:
 	size_t taps_count_ { 0 };
 	size_t decimation_factor_ { 1 };
 
-	template<typename T>
-	void configure(
-		const T* const taps,
-		const size_t taps_count,
-		const size_t decimation_factor
-	) {
-		configure_common(taps_count, decimation_factor);
-		std::reverse_copy(&taps[0], &taps[taps_count], &taps_reversed_[0]);
-	}
-
 	void configure_common(
 		const size_t taps_count,
 		const size_t decimation_factor
@@ -24,6 +24,10 @@
 #include "complex.hpp"
 #include "fxpt_atan2.hpp"
 #include "utility_m4.hpp"
+#include "sine_table.hpp"
+
+#include <cmath>
+#include <algorithm>
 
 #include <hal.h>
 
@@ -49,22 +53,124 @@ buffer_f32_t AM::execute(
 	return { dst.p, src.count, src.sampling_rate };
 }
 
-buffer_f32_t SSB::execute(
+/* Modified Bessel function of the first kind, order zero, by power series. */
+static float bessel_i0(const float x) {
+	const float q = x * x * 0.25f;
+	float term = 1.0f;
+	float sum = 1.0f;
+	for(size_t k=1; k<32; k++) {
+		term *= q / static_cast<float>(k * k);
+		sum += term;
+		if( term < (sum * 1e-7f) ) {
+			break;
+		}
+	}
+	return sum;
+}
+
+void SSB::configure(
+	const float sampling_rate,
+	const float low_hz,
+	const float high_hz,
+	const float bfo_hz,
+	const bool lower_sideband
+) {
+	/* Passband relative to carrier, before BFO. Lower sideband is mirrored
+	 * here and un-mirrored by conjugation in execute().
+	 */
+	const float upper_low = low_hz - bfo_hz;
+	const float upper_high = high_hz - bfo_hz;
+	const float band_low = lower_sideband ? -upper_high : upper_low;
+	const float band_high = lower_sideband ? -upper_low : upper_high;
+
+	/* Kaiser-windowed sinc low-pass prototype, shifted to the passband
+	 * center. The cutoff sits mid-transition, so the passband edges are
+	 * where they were asked for.
+	 */
+	const float half_width = (band_high - band_low) * 0.5f;
+	const float transition_wanted = std::max(transition_min_hz, std::min(transition_max_hz, (band_high - band_low) * transition_ratio));
+	const float kaiser_d = (stop_attenuation_db - 7.95f) / (2.285f * 2.0f * pi);
+	const size_t taps_wanted = std::ceil(kaiser_d * sampling_rate / transition_wanted) + 1;
+	taps_count_ = std::min(taps_count_max, (taps_wanted + 7) & ~static_cast<size_t>(7));
+	const float transition = kaiser_d * sampling_rate / (taps_count_ - 1);
+
+	const float center = (band_low + band_high) * 0.5f / sampling_rate;
+	const float cutoff = (half_width + transition * 0.5f) / sampling_rate;
+	const float beta = 0.1102f * (stop_attenuation_db - 8.7f);
+	const float window_k = 1.0f / bessel_i0(beta);
+
+	/* Evaluated twice rather than buffered, to keep taps_count_max floats
+	 * off the stack.
+	 */
+	const auto prototype = [this, cutoff, beta, window_k](const float m) {
+		const float sinc = (m == 0.0f) ? (2.0f * cutoff) : (std::sin(2.0f * pi * cutoff * m) / (pi * m));
+		const float r = 2.0f * m / (taps_count_ - 1);
+		const float window = bessel_i0(beta * std::sqrt(std::max(0.0f, 1.0f - r * r))) * window_k;
+		return sinc * window;
+	};
+
+	float prototype_sum = 0.0f;
+	for(size_t n=0; n<taps_count_; n++) {
+		prototype_sum += prototype(static_cast<float>(n) - (taps_count_ - 1) * 0.5f);
+	}
+
+	const float k_taps = 65536.0f / prototype_sum;
+	for(size_t n=0; n<taps_count_; n++) {
+		const float m = static_cast<float>(n) - (taps_count_ - 1) * 0.5f;
+		const float t = prototype(m) * k_taps;
+		const float theta = 2.0f * pi * center * m;
+		const auto tap_real = std::max(-32768L, std::min(32767L, std::lround(t * std::cos(theta))));
+		const auto tap_imag = std::max(-32768L, std::min(32767L, std::lround(t * std::sin(theta))));
+		taps_[n] = { static_cast<int16_t>(tap_real), static_cast<int16_t>(tap_imag) };
+	}
+
+	passband_frequency_ = std::max(std::abs(band_low), std::abs(band_high));
+	stop_frequency_ = passband_frequency_ + transition;
+
+	bfo_phase = 0;
+	bfo_phase_inc = static_cast<int32_t>(std::lround(bfo_hz / sampling_rate * 4294967296.0f));
+	lower_sideband_ = lower_sideband;
+	agc_envelope = agc_envelope_min << agc_envelope_bits;
+}
+
+buffer_s16_t SSB::execute(
 	const buffer_c16_t& src,
-	const buffer_f32_t& dst
+	const buffer_s16_t& dst
 ) {
-	const complex16_t* src_p = src.p;
-	const auto src_end = &src.p[src.count];
-	auto dst_p = dst.p;
-	while(src_p < src_end) {
-		*(dst_p++) = (src_p++)->real() * k;
-		*(dst_p++) = (src_p++)->real() * k;
-		*(dst_p++) = (src_p++)->real() * k;
-		*(dst_p++) = (src_p++)->real() * k;
+	auto phase = bfo_phase;
+	auto envelope = agc_envelope;
+	/* LSB: product detect conj(x), which mirrors the passband back up. */
+	const int32_t k_imag = lower_sideband_ ? 1 : -1;
+
+	for(size_t i=0; i<src.count; i++) {
+		const int32_t x_real = src.p[i].real();
+		const int32_t x_imag = src.p[i].imag();
+		const int32_t lo_cos = cos_s16(phase);
+		const int32_t lo_sin = sin_s16(phase);
+		phase += bfo_phase_inc;
+
+		const int32_t y = (x_real * lo_cos + k_imag * x_imag * lo_sin) >> 15;
+
+		const int32_t magnitude = ((y < 0) ? -y : y) << agc_envelope_bits;
+		if( magnitude > envelope ) {
+			envelope += (magnitude - envelope) >> agc_attack_shift;
+		} else {
+			envelope -= envelope >> agc_decay_shift;
+		}
+		const int32_t envelope_floor = agc_envelope_min << agc_envelope_bits;
+		if( envelope < envelope_floor ) {
+			envelope = envelope_floor;
+		}
+
+		dst.p[i] = __SSAT((y * agc_target) / (envelope >> agc_envelope_bits), 16);
 	}
 
+	bfo_phase = phase;
+	agc_envelope = envelope;
+
 	return { dst.p, src.count, src.sampling_rate };
 }
+
 /*
 static inline float angle_approx_4deg0(const complex32_t t) {
 	const auto x = static_cast<float>(t.imag()) / static_cast<float>(t.real());
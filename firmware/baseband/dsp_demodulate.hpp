@@ -24,6 +24,12 @@
 
 #include "dsp_types.hpp"
 
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
 namespace dsp {
 namespace demodulate {
 
@@ -38,15 +44,84 @@ private:
 	static constexpr float k = 1.0f / 32768.0f;
 };
 
+/* Single sideband / CW product detector with AGC.
+ *
+ * configure() designs the complex band-pass channel filter for the
+ * requested audio passband, to be run by FIRAndDecimateComplex ahead of
+ * execute(). execute() is integer-only: BFO mix, sideband selection by
+ * real part, then peak-envelope AGC.
+ */
 class SSB {
 public:
-	buffer_f32_t execute(
+	static constexpr size_t taps_count_max = 256;
+	using taps_t = std::array<complex16_t, taps_count_max>;
+
+	/* Passband edges are audio frequencies after the BFO, so for CW the
+	 * filter is centered on the carrier and the BFO sets the tone pitch.
+	 */
+	void configure(
+		const float sampling_rate,
+		const float low_hz,
+		const float high_hz,
+		const float bfo_hz,
+		const bool lower_sideband
+	);
+
+	/* Channel filter taps, normalized to 1 << 16 == 1.0. The first
+	 * channel_taps_count() are used.
+	 */
+	const taps_t& channel_taps() const {
+		return taps_;
+	}
+
+	size_t channel_taps_count() const {
+		return taps_count_;
+	}
+
+	/* Baseband frequency extent of the channel filter passband. */
+	float passband_frequency() const {
+		return passband_frequency_;
+	}
+
+	/* Baseband frequency extent of the channel filter transition band, as
+	 * designed.
+	 */
+	float stop_frequency() const {
+		return stop_frequency_;
+	}
+
+	buffer_s16_t execute(
 		const buffer_c16_t& src,
-		const buffer_f32_t& dst
+		const buffer_s16_t& dst
 	);
 
 private:
-	static constexpr float k = 1.0f / 32768.0f;
+	static constexpr int32_t agc_target = 8192;
+	/* Envelope is kept with 12 fractional bits to track slow decay. */
+	static constexpr size_t agc_envelope_bits = 12;
+	static constexpr size_t agc_attack_shift = 2;
+	static constexpr size_t agc_decay_shift = 11;
+	/* Limits AGC gain to agc_target / agc_envelope_min (48dB). */
+	static constexpr int32_t agc_envelope_min = 32;
+
+	/* Kaiser window design, 60dB stop band plus 1dB margin for the Kaiser
+	 * estimate and tap rounding. Transition is 40% of the passband width,
+	 * from 150Hz to 300Hz, and wider if that would take more than
+	 * taps_count_max taps.
+	 */
+	static constexpr float stop_attenuation_db = 61.0f;
+	static constexpr float transition_ratio = 0.4f;
+	static constexpr float transition_min_hz = 150.0f;
+	static constexpr float transition_max_hz = 300.0f;
+
+	taps_t taps_ { };
+	size_t taps_count_ { 0 };
+	float passband_frequency_ { 0.0f };
+	float stop_frequency_ { 0.0f };
+	uint32_t bfo_phase { 0 };
+	uint32_t bfo_phase_inc { 0 };
+	bool lower_sideband_ { false };
+	int32_t agc_envelope { agc_envelope_min << agc_envelope_bits };
 };
 
 class FM {
@@ -24,6 +24,8 @@
 #include <cstdint>
 #include <array>
 
+#include <hal.h>
+
 bool FMSquelch::execute(const buffer_f32_t& audio) {
 	if( threshold_squared == 0.0f ) {
 		return true;
@@ -51,3 +53,50 @@ bool FMSquelch::execute(const buffer_f32_t& audio) {
 void FMSquelch::set_threshold(const float new_value) {
 	threshold_squared = new_value * new_value;
 }
+
+void FMSquelch::reset() {
+	non_audio_hpf.reset();
+}
+
+bool ChannelActivityDetector::execute(const buffer_c16_t& channel) {
+	const void* src_p = channel.p;
+	const auto src_end = &channel.p[channel.count];
+	while(src_p < src_end) {
+		const uint32_t sample = *__SIMD32(src_p)++;
+		power_sum = __SMLALD(sample, sample, power_sum);
+	}
+	power_count += channel.count;
+
+	if( power_count < (1U << window_log2) ) {
+		return false;
+	}
+
+	const uint32_t power = power_sum / power_count;
+	power_sum = 0;
+	power_count = 0;
+
+	if( !floor_valid ) {
+		floor = power;
+		floor_valid = true;
+		return false;
+	}
+
+	if( power > (floor + (floor >> threshold_log2)) ) {
+		return true;
+	}
+
+	if( power > (floor + (floor >> hold_log2)) ) {
+		return false;
+	}
+
+	const int32_t delta = static_cast<int32_t>(power - floor) >> floor_tau_log2;
+	floor += delta;
+
+	return false;
+}
+
+void ChannelActivityDetector::reset() {
+	power_sum = 0;
+	power_count = 0;
+	floor_valid = false;
+}
@@ -22,7 +22,7 @@
 #ifndef __DSP_SQUELCH_H__
 #define __DSP_SQUELCH_H__
 
-#include "buffer.hpp"
+#include "dsp_types.hpp"
 #include "dsp_iir.hpp"
 #include "dsp_iir_config.hpp"
 
@@ -34,6 +34,7 @@ public:
 	bool execute(const buffer_f32_t& audio);
 
 	void set_threshold(const float new_value);
+	void reset();
 
 private:
 	static constexpr size_t N = 32;
@@ -42,4 +43,39 @@ private:
 	IIRBiquadFilter non_audio_hpf { non_audio_hpf_config };
 };
 
+/* Cheap channel power detector used to wake a demodulator from its idle state.
+ * Integrates channel power over a fixed window spanning several blocks, tracks
+ * the noise floor from those window estimates, and reports activity when a
+ * window rises above the floor by a small ratio. The floor is held while power
+ * is above it, so a slowly rising signal can't drag it up.
+ *
+ * The threshold is well below the SNR at which the FM noise squelch opens, so
+ * any signal it would pass wakes the demodulator. A false wake costs one
+ * squelch hang period of full processing.
+ */
+class ChannelActivityDetector {
+public:
+	bool execute(const buffer_c16_t& channel);
+
+	/* Discard the floor. The next full window seeds it. */
+	void reset();
+
+private:
+	/* Power is integrated over 2^9 samples before each decision. On channel
+	 * noise the window estimate's standard deviation is ~5% of the floor.
+	 */
+	static constexpr size_t window_log2 = 9;
+	/* Activity when window power exceeds floor by 2^-2 (1dB, ~5 sigma). */
+	static constexpr size_t threshold_log2 = 2;
+	/* Floor is held when window power exceeds it by 2^-3 (0.5dB). */
+	static constexpr size_t hold_log2 = 3;
+	/* Floor tracks window power with time constant of 2^3 windows. */
+	static constexpr size_t floor_tau_log2 = 3;
+
+	uint64_t power_sum { 0 };
+	size_t power_count { 0 };
+	uint32_t floor { 0 };
+	bool floor_valid { false };
+};
+
 #endif/*__DSP_SQUELCH_H__*/
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_stereo.hpp"
+
+#include "sine_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <hal.h>
+
+namespace dsp {
+namespace stereo {
+
+void PilotPLL::configure(const uint32_t sampling_rate) {
+	/* Loop natural frequency and damping. */
+	constexpr float loop_bandwidth_hz = 20.0f;
+	constexpr float damping = 0.707f;
+	/* Phase detector gain: nominal pilot amplitude / 2, in Q15 units per radian. */
+	constexpr float kd = 3277.0f / 2.0f;
+	constexpr float phase_units_per_radian = 4294967296.0f / (2.0f * pi);
+
+	const float wn_t = 2.0f * pi * loop_bandwidth_hz / sampling_rate;
+	const float kp_f = 2.0f * damping * wn_t / kd * phase_units_per_radian;
+	const float ki_f = wn_t * wn_t / kd * phase_units_per_radian * 65536.0f;
+
+	phase_ = 0;
+	phase_inc_nominal_ = static_cast<float>(pilot_frequency) / sampling_rate * 4294967296.0f;
+	kp_ = std::lround(kp_f);
+	ki_ = std::lround(ki_f);
+	integrator_ = 0;
+	/* Limit tracking range to +/-100Hz of nominal. */
+	integrator_limit_ = static_cast<int64_t>(100.0f / sampling_rate * 4294967296.0f) << 16;
+	level_accum_ = 0;
+}
+
+void Decoder::configure(const uint32_t sampling_rate) {
+	pll.configure(sampling_rate);
+	blend_ = 0;
+}
+
+buffer_s16_t Decoder::execute(
+	const buffer_s16_t& src,
+	const buffer_s16_t& dst
+) {
+	const int32_t blend = blend_;
+
+	auto src_p = src.p;
+	const auto src_end = &src.p[src.count];
+	auto dst_p = dst.p;
+	while(src_p < src_end) {
+		const int32_t x = *(src_p++);
+
+		const auto phase = pll.phase();
+		const int32_t s = sin_s16(phase);
+		const int32_t c = cos_s16(phase);
+		pll.update(x, s, c);
+
+		/* sin(2 * phi) = 2 * sin(phi) * cos(phi) */
+		const int32_t s2 = (s * c) >> 14;
+		const int32_t difference = (((x * s2) >> 15) * subcarrier_gain) >> 12;
+		const int32_t difference_blended = (difference * blend) >> 15;
+		*(dst_p++) = __SSAT(difference_blended, 16);
+	}
+
+	update_blend();
+
+	return { dst.p, src.count, src.sampling_rate };
+}
+
+void Decoder::update_blend() {
+	const int32_t level = pll.pilot_level();
+	const int32_t level_clipped = std::max(std::min(level, pilot_level_stereo), pilot_level_mono);
+	const int32_t target = (level_clipped - pilot_level_mono) * 32767 / (pilot_level_stereo - pilot_level_mono);
+
+	if( target > blend_ ) {
+		blend_ = std::min(blend_ + blend_step, target);
+	} else {
+		blend_ = std::max(blend_ - blend_step, target);
+	}
+}
+
+} /* namespace stereo */
+} /* namespace dsp */
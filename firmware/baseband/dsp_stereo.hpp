@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_STEREO_H__
+#define __DSP_STEREO_H__
+
+#include "dsp_types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+namespace dsp {
+namespace stereo {
+
+/* Second-order PLL tracking the 19kHz broadcast FM pilot tone.
+ * Phase is unsigned 32-bit, full scale == 2 * pi.
+ */
+class PilotPLL {
+public:
+	static constexpr uint32_t pilot_frequency = 19000;
+
+	void configure(const uint32_t sampling_rate);
+
+	uint32_t phase() const {
+		return phase_;
+	}
+
+	/* Averaged in-phase pilot amplitude, Q15. Near zero when not locked. */
+	int32_t pilot_level() const {
+		return level_accum_ >> level_tau_log2;
+	}
+
+	/* x: composite sample. sin/cos: Q15 oscillator output at phase(). */
+	void update(const int32_t x, const int32_t sin, const int32_t cos) {
+		/* x * cos(phi) ~= A/2 * sin(theta - phi), x * sin(phi) ~= A/2 * cos(theta - phi) */
+		const int32_t error = (x * cos) >> 15;
+		const int32_t in_phase = (x * sin) >> 15;
+
+		level_accum_ += in_phase - pilot_level();
+
+		integrator_ += static_cast<int64_t>(ki_) * error;
+		if( integrator_ > integrator_limit_ ) {
+			integrator_ = integrator_limit_;
+		}
+		if( integrator_ < -integrator_limit_ ) {
+			integrator_ = -integrator_limit_;
+		}
+
+		const int32_t frequency = phase_inc_nominal_ + static_cast<int32_t>(integrator_ >> 16) + kp_ * error;
+		phase_ += frequency;
+	}
+
+private:
+	/* Level average time constant of 2^12 samples (21ms at 192kHz). */
+	static constexpr size_t level_tau_log2 = 12;
+
+	uint32_t phase_ { 0 };
+	uint32_t phase_inc_nominal_ { 0 };
+	int32_t kp_ { 0 };
+	int32_t ki_ { 0 };
+	int64_t integrator_ { 0 };
+	int64_t integrator_limit_ { 0 };
+	int32_t level_accum_ { 0 };
+};
+
+/* Recovers the L-R difference signal from an FM composite (MPX) signal using
+ * a 38kHz reference derived from the pilot PLL. The difference signal is
+ * scaled by a stereo blend factor that fades to mono as the pilot weakens.
+ * Output still contains products around 76kHz, and must be low-pass filtered
+ * like the L+R signal before the L/R matrix.
+ */
+class Decoder {
+public:
+	void configure(const uint32_t sampling_rate);
+
+	buffer_s16_t execute(
+		const buffer_s16_t& src,
+		const buffer_s16_t& dst
+	);
+
+	const PilotPLL& pilot_pll() const {
+		return pll;
+	}
+
+	/* Q15, 0 == mono, 32767 == full stereo separation. */
+	int32_t blend() const {
+		return blend_;
+	}
+
+private:
+	/* Nominal pilot is 10% of 75kHz deviation == 3277 in demodulator output.
+	 * PLL in-phase level is half of the pilot amplitude.
+	 */
+	static constexpr int32_t pilot_level_mono = 400;
+	static constexpr int32_t pilot_level_stereo = 800;
+	/* Blend moves at most 1/64 of full scale per block. */
+	static constexpr int32_t blend_step = 512;
+	/* Subcarrier demodulation gain: 2.0 for DSB-SC, times 1.1 to make up for
+	 * the CIC droop at 38kHz ahead of this stage. Q12.
+	 */
+	static constexpr int32_t subcarrier_gain = 9011;
+
+	PilotPLL pll { };
+	int32_t blend_ { 0 };
+
+	void update_blend();
+};
+
+} /* namespace stereo */
+} /* namespace dsp */
+
+#endif/*__DSP_STEREO_H__*/
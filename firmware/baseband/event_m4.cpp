@@ -89,21 +89,22 @@ void EventDispatcher::dispatch(const eventmask_t events) {
 }
 
 void EventDispatcher::handle_baseband_queue() {
-	const auto message = shared_memory.baseband_message;
-	if( message ) {
-		on_message(message);
-	}
+	shared_memory.baseband_queue.handle([this](Message* const message) {
+		this->on_message(message);
+	});
 }
 
 void EventDispatcher::on_message(const Message* const message) {
 	switch(message->id) {
 	case Message::ID::Shutdown:
+		/* Completed on exit, once nothing more will be queued to the M0. */
 		on_message_shutdown(*reinterpret_cast<const ShutdownMessage*>(message));
 		break;
 
 	default:
 		on_message_default(message);
-		shared_memory.baseband_message = nullptr;
+		__DMB();
+		shared_memory.baseband_completed = shared_memory.baseband_completed + 1;
 		break;
 	}
 }
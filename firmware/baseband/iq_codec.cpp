@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "iq_codec.hpp"
+
+#include <hal.h>
+
+#include <cstring>
+
+namespace iq_codec {
+
+namespace {
+
+class BitWriter {
+public:
+	BitWriter(
+		uint32_t* const p,
+		const uint32_t* const end
+	) : p { p },
+		end { end }
+	{
+	}
+
+	/* Appends the low n bits of value (n <= 32). */
+	void put(const uint32_t value, const uint32_t n) {
+		acc = (acc << n) | value;
+		bits += n;
+		if( bits >= 32 ) {
+			bits -= 32;
+			if( p < end ) {
+				*p = acc >> bits;
+			}
+			p++;
+		}
+	}
+
+	/* Pads to a word boundary, returns the end of the output. */
+	uint32_t* flush() {
+		if( bits ) {
+			put(0, 32 - bits);
+		}
+		return p;
+	}
+
+	bool overflow() const {
+		return p > end;
+	}
+
+private:
+	uint32_t* p;
+	const uint32_t* const end;
+	uint64_t acc { 0 };
+	uint32_t bits { 0 };
+};
+
+inline uint32_t zigzag(const int32_t v) {
+	return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline void put_rice(BitWriter& writer, const uint32_t v, const uint32_t k) {
+	const uint32_t q = v >> k;
+	if( q < escape_quotient ) {
+		/* q ones and a terminating zero, then the remainder. */
+		writer.put(((1U << q) - 1) << 1, q + 1);
+		writer.put(v & ((1U << k) - 1), k);
+	} else {
+		writer.put((1U << escape_quotient) - 1, escape_quotient);
+		writer.put(v, escape_bits);
+	}
+}
+
+/* For geometric-ish residuals, k near log2 of the mean is close to optimal. */
+uint32_t rice_parameter(const uint32_t sum, const size_t count) {
+	const uint32_t mean = sum / count;
+	const uint32_t k = mean ? (31 - __CLZ(mean)) : 0;
+	return (k < k_max) ? k : k_max;
+}
+
+} /* namespace */
+
+size_t encode(const complex16_t* const src, const size_t count, void* const dst) {
+	auto header = static_cast<BlockHeader*>(dst);
+	header->magic = block_magic;
+	header->sample_count = count;
+	header->first = count ? src[0] : complex16_t { 0, 0 };
+
+	uint32_t* const payload = reinterpret_cast<uint32_t*>(header + 1);
+	const size_t raw_size = (count > 1) ? ((count - 1) * sizeof(complex16_t)) : 0;
+
+	uint32_t sum_i = 0;
+	uint32_t sum_q = 0;
+	for(size_t n=1; n<count; n++) {
+		sum_i += zigzag(src[n].real() - src[n - 1].real());
+		sum_q += zigzag(src[n].imag() - src[n - 1].imag());
+	}
+
+	if( count > 1 ) {
+		const uint32_t k_i = rice_parameter(sum_i, count - 1);
+		const uint32_t k_q = rice_parameter(sum_q, count - 1);
+
+		BitWriter writer { payload, payload + raw_size / sizeof(uint32_t) };
+		for(size_t n=1; n<count; n++) {
+			put_rice(writer, zigzag(src[n].real() - src[n - 1].real()), k_i);
+			put_rice(writer, zigzag(src[n].imag() - src[n - 1].imag()), k_q);
+			if( writer.overflow() ) {
+				break;
+			}
+		}
+		const auto payload_end = writer.flush();
+
+		const size_t payload_size = (payload_end - payload) * sizeof(uint32_t);
+		if( !writer.overflow() && (payload_size < raw_size) ) {
+			header->k_i = k_i;
+			header->k_q = k_q;
+			header->payload_size = payload_size;
+			return sizeof(BlockHeader) + payload_size;
+		}
+	}
+
+	header->k_i = k_raw;
+	header->k_q = k_raw;
+	header->payload_size = raw_size;
+	if( raw_size ) {
+		memcpy(payload, &src[1], raw_size);
+	}
+	return sizeof(BlockHeader) + raw_size;
+}
+
+} /* namespace iq_codec */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __IQ_CODEC_H__
+#define __IQ_CODEC_H__
+
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+/* Lossless complex16 compression for captures (.RIQ files).
+ *
+ * A file is a sequence of independent blocks, each a BlockHeader followed
+ * by payload_size bytes. Each block starts with a raw sample, so decoding
+ * can begin at any block (find the magic, check payload_size).
+ *
+ * The other samples are coded as first differences, I and Q alternating,
+ * zigzag-mapped to unsigned and Rice coded with a parameter chosen per
+ * block and component: quotient in unary (ones, then a zero), then k
+ * remainder bits. A quotient of escape_quotient or more is sent as
+ * escape_quotient ones followed by escape_bits of the raw zigzag value.
+ * Bits are packed MSB first into little-endian 32-bit words.
+ *
+ * If coding doesn't beat the raw size, k_i is k_raw and the payload is
+ * the remaining samples as plain complex16.
+ */
+namespace iq_codec {
+
+struct BlockHeader {
+	uint32_t magic;
+	uint16_t sample_count;
+	uint8_t k_i;
+	uint8_t k_q;
+	complex16_t first;
+	uint32_t payload_size;
+};
+
+static_assert(sizeof(BlockHeader) == 16, "BlockHeader size wrong");
+
+constexpr uint32_t block_magic = 0x31514952;	/* "RIQ1" */
+constexpr uint8_t k_raw = 0xff;
+constexpr uint32_t k_max = 16;
+constexpr uint32_t escape_quotient = 24;
+constexpr uint32_t escape_bits = 17;
+
+constexpr size_t block_size_max(const size_t sample_count) {
+	return sizeof(BlockHeader) + sample_count * sizeof(complex16_t);
+}
+
+/* Encodes count samples (at most 16384) into dst, which must be word
+ * aligned and hold block_size_max(count) bytes. Returns the block size.
+ */
+size_t encode(const complex16_t* const src, const size_t count, void* const dst);
+
+} /* namespace iq_codec */
+
+#endif/*__IQ_CODEC_H__*/
@@ -24,8 +24,11 @@
 
 #include <cstdint>
 #include <cstddef>
-#include <bitset>
 #include <functional>
+#include <type_traits>
+#include <algorithm>
+#include <array>
+#include <tuple>
 
 #include "bit_pattern.hpp"
 #include "baseband_packet.hpp"
@@ -44,7 +47,40 @@ struct FixedLength {
 	const size_t length;
 };
 
-template<typename PreambleMatcher, typename UnstuffMatcher, typename EndMatcher>
+/* Collects sliced symbols into a word, oldest symbol most significant, for
+ * PacketBuilder::execute(symbols, count) on one or more builders.
+ */
+class SymbolWord {
+public:
+	template<typename... Sinks>
+	void add(const uint_fast8_t symbol, Sinks&... sinks) {
+		bits = (bits << 1) | (symbol & 1);
+		count++;
+		if( count == 32 ) {
+			flush(sinks...);
+		}
+	}
+
+	template<typename... Sinks>
+	void flush(Sinks&... sinks) {
+		if( count > 0 ) {
+			(sinks.execute(bits, count), ...);
+			bits = 0;
+			count = 0;
+		}
+	}
+
+private:
+	uint32_t bits { 0 };
+	size_t count { 0 };
+};
+
+template<
+	typename PreambleMatcher,
+	typename UnstuffMatcher,
+	typename EndMatcher,
+	typename PayloadHandler = std::function<void(const baseband::Packet& packet)>
+>
 class PacketBuilder {
 public:
 	using PayloadHandlerFunc = std::function<void(const baseband::Packet& packet)>;
@@ -53,7 +89,7 @@ public:
 		const PreambleMatcher preamble_matcher,
 		const UnstuffMatcher unstuff_matcher,
 		const EndMatcher end_matcher,
-		PayloadHandlerFunc payload_handler
+		PayloadHandler payload_handler
 	) : payload_handler { std::move(payload_handler) },
 		preamble(preamble_matcher),
 		unstuff(unstuff_matcher),
@@ -88,20 +124,7 @@ public:
 				packet.add(symbol);
 			}
 
-			if( end(bit_history, packet.size()) ) {
-				// NOTE: This check is to avoid std::function nullptr check, which
-				// brings in "_ZSt25__throw_bad_function_callv" and a lot of extra code.
-				// TODO: Make payload_handler known at compile time.
-				if( payload_handler ) {
-					packet.set_timestamp(Timestamp::now());
-					payload_handler(packet);
-				}
-				reset_state();
-			} else {
-				if( packet_truncated() ) {
-					reset_state();
-				}
-			}
+			check_payload_end();
 			break;
 
 		default:
@@ -110,6 +133,67 @@ public:
 		}
 	}
 
+	/* Begin a payload when the preamble was found upstream. history holds
+	 * the final count (1 to 32) preamble symbols for the unstuff and end
+	 * matchers.
+	 */
+	void start_payload(
+		const uint32_t history,
+		const size_t count
+	) {
+		reset_state();
+		bit_history.add(history, count);
+		state = State::Payload;
+	}
+
+	bool is_receiving() const {
+		return state == State::Payload;
+	}
+
+	/* Process count (1 to 32) symbols, oldest symbol in bit (count - 1).
+	 * Fixed-length payloads without unstuffing are appended a word at a
+	 * time; everything else is matched bit by bit.
+	 */
+	void execute(
+		const uint32_t symbols,
+		const size_t count
+	) {
+		size_t remaining = count;
+		while(remaining > 0) {
+			if( is_receiving() ) {
+				remaining -= execute_payload(symbols, remaining);
+			} else {
+				remaining--;
+				execute((symbols >> remaining) & 1);
+			}
+		}
+	}
+
+	/* Feed payload symbols from the low count (1 to 32) bits of symbols,
+	 * oldest in bit (count - 1), while receiving. Returns the number of
+	 * symbols consumed, less than count if the payload ended.
+	 */
+	size_t execute_payload(
+		const uint32_t symbols,
+		const size_t count
+	) {
+		size_t remaining = count;
+		while( (remaining > 0) && is_receiving() ) {
+			const size_t n = payload_span(remaining);
+			if( n > 0 ) {
+				const uint32_t chunk = symbols >> (remaining - n);
+				bit_history.add(chunk, n);
+				packet.add_bits(chunk, n);
+				remaining -= n;
+				check_payload_end();
+			} else {
+				remaining--;
+				execute((symbols >> remaining) & 1);
+			}
+		}
+		return count - remaining;
+	}
+
 private:
 	enum State {
 		Preamble,
@@ -120,7 +204,7 @@ private:
 		return packet.size() >= packet.capacity();
 	}
 
-	const PayloadHandlerFunc payload_handler;
+	const PayloadHandler payload_handler;
 
 	BitHistory bit_history { };
 	PreambleMatcher preamble { };
@@ -134,6 +218,138 @@ private:
 		packet.clear();
 		state = State::Preamble;
 	}
+
+	/* Number of symbols that can be appended to the payload in bulk. */
+	size_t payload_span(const size_t available) const {
+		if constexpr (std::is_same<UnstuffMatcher, NeverMatch>::value && std::is_same<EndMatcher, FixedLength>::value) {
+			if( (state == State::Payload) && (end.length > packet.size()) ) {
+				return std::min(available, end.length - packet.size());
+			}
+		}
+		return 0;
+	}
+
+	void check_payload_end() {
+		if( end(bit_history, packet.size()) ) {
+			packet.set_timestamp(Timestamp::now());
+			handle_payload(payload_handler, packet);
+			reset_state();
+		} else {
+			if( packet_truncated() ) {
+				reset_state();
+			}
+		}
+	}
+
+	template<typename Handler>
+	static void handle_payload(const Handler& handler, const baseband::Packet& packet) {
+		handler(packet);
+	}
+
+	static void handle_payload(const PayloadHandlerFunc& handler, const baseband::Packet& packet) {
+		// NOTE: This check is to avoid std::function nullptr check, which
+		// brings in "_ZSt25__throw_bad_function_callv" and a lot of extra code.
+		if( handler ) {
+			handler(packet);
+		}
+	}
+};
+
+/* Matches one symbol history against the preambles of several builders
+ * fed the same symbol stream, a word of symbols at a time (see SymbolWord).
+ * Builders receiving a payload take their symbols in bulk. For idle
+ * builders the history at each symbol is formed once and compared against
+ * every idle builder's preamble; one that matches starts a payload and
+ * takes the rest of the word. Builders use NeverMatch preamble matchers;
+ * pattern N belongs to the Nth builder.
+ */
+template<typename... Builders>
+class PreambleMatcherBank {
+public:
+	static constexpr size_t N = sizeof...(Builders);
+
+	constexpr PreambleMatcherBank(
+		const std::array<BitPattern, N>& patterns,
+		Builders&... builders
+	) : builders { builders... }
+	{
+		for(size_t i=0; i<N; i++) {
+			codes[i] = patterns[i].code() & patterns[i].mask();
+			masks[i] = patterns[i].mask();
+			tolerances[i] = patterns[i].maximum_hanning_distance();
+		}
+	}
+
+	/* Process count (1 to 32) symbols, oldest symbol in bit (count - 1). */
+	void execute(
+		const uint32_t symbols,
+		const size_t count
+	) {
+		const uint64_t history_before = history.value();
+		history.add(symbols, count);
+
+		/* Symbols of this word each builder has been given. */
+		std::array<size_t, N> consumed;
+		size_t index = 0;
+		std::apply([&](auto&... b) {
+			((consumed[index++] = b.is_receiving() ? b.execute_payload(symbols, count) : 0), ...);
+		}, builders);
+
+		for(size_t j=1; j<=count; j++) {
+			if( std::all_of(consumed.begin(), consumed.end(), [count](const size_t c) { return c >= count; }) ) {
+				break;
+			}
+
+			const uint64_t h = (history_before << j) | ((symbols & (0xffffffffU >> (32 - count))) >> (count - j));
+			index = 0;
+			std::apply([&](auto&... b) {
+				(dispatch(h, symbols, count, j, index++, consumed, b), ...);
+			}, builders);
+		}
+	}
+
+private:
+	BitHistory history { };
+	std::tuple<Builders&...> builders;
+	std::array<uint64_t, N> codes { };
+	std::array<uint64_t, N> masks { };
+	std::array<size_t, N> tolerances { };
+
+	/* Hamming distance at most tolerance, by clearing the lowest set bit
+	 * tolerance times; cheaper than a 64-bit popcount on the M4.
+	 */
+	static bool within_distance(uint64_t delta_bits, size_t tolerance) {
+		while( (delta_bits != 0) && (tolerance > 0) ) {
+			delta_bits &= delta_bits - 1;
+			tolerance--;
+		}
+		return delta_bits == 0;
+	}
+
+	/* h: history after symbol j of the word. Only acts on builders idle
+	 * at symbol j.
+	 */
+	template<typename Builder>
+	void dispatch(
+		const uint64_t h,
+		const uint32_t symbols,
+		const size_t count,
+		const size_t j,
+		const size_t i,
+		std::array<size_t, N>& consumed,
+		Builder& builder
+	) {
+		if( consumed[i] >= j ) {
+			return;
+		}
+		consumed[i] = j;
+		if( within_distance((h & masks[i]) ^ codes[i], tolerances[i]) ) {
+			builder.start_payload(static_cast<uint32_t>(h), 32);
+			if( j < count ) {
+				consumed[i] += builder.execute_payload(symbols, count - j);
+			}
+		}
+	}
 };
 
 #endif/*__PACKET_BUILDER_H__*/
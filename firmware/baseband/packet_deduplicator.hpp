@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PACKET_DEDUPLICATOR_H__
+#define __PACKET_DEDUPLICATOR_H__
+
+#include "baseband_packet.hpp"
+#include "manchester.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <algorithm>
+
+#include <ch.h>
+
+/* Suppresses packets identical to one seen within the time window. Packets
+ * are remembered by a 32-bit FNV-1a hash of their bits and a caller-chosen
+ * tag (packet type, < tags_count), in a small table that evicts the oldest
+ * entry.
+ */
+class PacketDeduplicator {
+public:
+	static constexpr size_t tags_count = 4;
+
+	constexpr PacketDeduplicator(
+		const uint32_t window_ms
+	) : window { MS2ST(window_ms) }
+	{
+	}
+
+	/* True if the packet is new and should be queued. */
+	bool operator()(const baseband::Packet& packet, const uint32_t tag = 0) {
+		return check(hash(packet, packet.size(), tag), tag);
+	}
+
+	bool operator()(const ManchesterPacket& packet, const uint32_t tag = 0) {
+		return check(hash(packet, packet.symbols_count(), tag), tag);
+	}
+
+	/* Compare only the first symbols_count symbols, e.g. up to the end of
+	 * a variable-length payload.
+	 */
+	bool operator()(const ManchesterPacket& packet, const uint32_t tag, const size_t symbols_count) {
+		return check(hash(packet, std::min(symbols_count, packet.symbols_count()), tag), tag);
+	}
+
+	/* Duplicates of tag suppressed since the last call, to report with the
+	 * next packet of that tag queued.
+	 */
+	uint32_t take_repeat_count(const uint32_t tag = 0) {
+		const auto result = repeat_counts[tag];
+		repeat_counts[tag] = 0;
+		return result;
+	}
+
+private:
+	struct Entry {
+		uint32_t hash { 0 };
+		systime_t seen { 0 };
+		bool used { false };
+	};
+
+	static constexpr size_t entries_count = 16;
+
+	const systime_t window;
+	std::array<Entry, entries_count> entries { };
+	std::array<uint32_t, tags_count> repeat_counts { };
+
+	template<typename T>
+	static uint32_t hash(const T& packet, const size_t bit_count, const uint32_t tag) {
+		uint32_t h = 2166136261U;
+		const auto mix = [&h](const uint32_t value) {
+			for(size_t i=0; i<4; i++) {
+				h = (h ^ ((value >> (i * 8)) & 0xff)) * 16777619U;
+			}
+		};
+
+		mix(tag);
+		mix(bit_count);
+		for(size_t i=0; i<(bit_count / 32); i++) {
+			mix(packet.word(i));
+		}
+		const size_t tail_bits = bit_count % 32;
+		if( tail_bits ) {
+			mix(packet.word(bit_count / 32) & ~(0xffffffffU >> tail_bits));
+		}
+		return h;
+	}
+
+	bool check(const uint32_t hash, const uint32_t tag) {
+		const auto now = chTimeNow();
+
+		/* Reuse an expired entry for the same packet, else a free entry,
+		 * else the oldest. A repeat does not refresh its entry, so a packet
+		 * sent continuously still gets through once per window.
+		 */
+		Entry* victim = &entries[0];
+		for(auto& entry : entries) {
+			if( entry.used && (entry.hash == hash) ) {
+				if( (now - entry.seen) < window ) {
+					repeat_counts[tag]++;
+					return false;
+				}
+				victim = &entry;
+				break;
+			}
+			if( victim->used && (!entry.used || ((now - entry.seen) > (now - victim->seen))) ) {
+				victim = &entry;
+			}
+		}
+
+		victim->hash = hash;
+		victim->seen = now;
+		victim->used = true;
+		return true;
+	}
+};
+
+#endif/*__PACKET_DEDUPLICATOR_H__*/
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PACKET_STATS_COLLECTOR_H__
+#define __PACKET_STATS_COLLECTOR_H__
+
+#include "dsp_types.hpp"
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+class PacketStatsCollector {
+public:
+	void accepted() {
+		statistics.accepted++;
+	}
+
+	void rejected_length() {
+		statistics.rejected_length++;
+	}
+
+	void rejected_crc() {
+		statistics.rejected_crc++;
+	}
+
+	template<typename Callback>
+	void process(const buffer_c8_t& buffer, Callback callback) {
+		count += buffer.count;
+
+		const size_t samples_per_update = buffer.sampling_rate * update_interval;
+
+		if( count >= samples_per_update ) {
+			callback(statistics);
+			count = 0;
+		}
+	}
+
+private:
+	static constexpr float update_interval { 1.0f };
+	PacketStatistics statistics { };
+	size_t count { 0 };
+};
+
+#endif/*__PACKET_STATS_COLLECTOR_H__*/
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "preamble_correlator.hpp"
+
+#include <cstring>
+
+#include <hal.h>
+
+namespace dsp {
+
+PreambleCorrelator::PreambleCorrelator(
+	const uint32_t levels,
+	const float threshold
+) {
+	level_sum = 0;
+	for(size_t i=0; i<symbol_count; i++) {
+		level_sum += ((levels >> (symbol_count - 1 - i)) & 1) ? 1 : -1;
+	}
+
+	last_level = (levels & 1) ? 1 : -1;
+
+	pattern_energy = 0;
+	for(size_t i=0; i<symbol_count; i++) {
+		const int32_t level = ((levels >> (symbol_count - 1 - i)) & 1) ? 1 : -1;
+		pattern[i] = static_cast<int32_t>(symbol_count) * level - level_sum;
+		pattern_energy += pattern[i] * pattern[i];
+	}
+
+	/* Correlation of the mean-removed pattern with a unit-amplitude
+	 * preamble: sum(pattern[i] * level[i]).
+	 */
+	pattern_symbol_gain = static_cast<int32_t>(symbol_count * symbol_count) - level_sum * level_sum;
+	threshold_q8 = threshold * 256.0f;
+}
+
+int32_t PreambleCorrelator::sample(const size_t age) const {
+	/* Newest sample is the last one written, in the phase before the current one. */
+	const size_t newest_phase = phase ^ 1;
+	const size_t p = (age & 1) ? phase : newest_phase;
+	return history[p][symbol_count - 1 - (age / samples_per_symbol)];
+}
+
+bool PreambleCorrelator::execute(const int16_t sample) {
+	auto& h = history[phase];
+	std::memmove(&h[0], &h[1], (symbol_count - 1) * sizeof(h[0]));
+	h[symbol_count - 1] = sample;
+	phase ^= 1;
+
+	const uint32_t* h_p = reinterpret_cast<const uint32_t*>(h.data());
+	const uint32_t* t_p = reinterpret_cast<const uint32_t*>(pattern.data());
+	int32_t correlation = 0;
+	int32_t sum = 0;
+	int64_t energy = 0;
+	for(size_t i=0; i<symbol_count/2; i++) {
+		const uint32_t s = *(h_p++);
+		correlation = __SMLAD(s, *(t_p++), correlation);
+		sum = __SMLAD(s, 0x00010001, sum);
+		energy = __SMLALD(s, s, energy);
+	}
+
+	/* Window energy with mean removed, times symbol_count. */
+	const int64_t energy_ac = energy * static_cast<int64_t>(symbol_count) - static_cast<int64_t>(sum) * sum;
+
+	/* Normalized correlation squared:
+	 * correlation^2 / (pattern_energy * energy_ac / symbol_count) > threshold
+	 */
+	const int64_t c2 = static_cast<int64_t>(correlation) * correlation;
+	const bool above = (energy_ac > 0) &&
+		((c2 * static_cast<int64_t>(symbol_count) * 256) > (pattern_energy * energy_ac * threshold_q8));
+
+	candidates[2] = candidates[1];
+	candidates[1] = candidates[0];
+	candidates[0] = { correlation, sum, above };
+
+	if( pending_valid ) {
+		pending_age++;
+	}
+
+	/* Correlation peak at the previous sample? */
+	const auto& a = candidates[2];
+	const auto& b = candidates[1];
+	const auto& c = candidates[0];
+	const int32_t ma = (a.correlation < 0) ? -a.correlation : a.correlation;
+	const int32_t mb = (b.correlation < 0) ? -b.correlation : b.correlation;
+	const int32_t mc = (c.correlation < 0) ? -c.correlation : c.correlation;
+	if( b.valid && (mb > ma) && (mb >= mc) && (!pending_valid || (mb > pending_magnitude)) ) {
+		/* Parabolic interpolation of peak position, -0.5 to +0.5 samples. */
+		const int32_t denominator = 2 * (ma - 2 * mb + mc);
+		const int32_t delta = (denominator != 0) ? static_cast<int32_t>((static_cast<int64_t>(ma - mc) << 16) / denominator) : 0;
+		const int32_t amplitude = b.correlation / pattern_symbol_gain;
+
+		pending = {
+			.offset = delta,
+			.symbol = amplitude * last_level,
+			.bias = (b.sum - amplitude * level_sum) / static_cast<int32_t>(symbol_count),
+		};
+		pending_magnitude = mb;
+		pending_age = 1;
+		pending_valid = true;
+	}
+
+	/* Report the strongest peak once no stronger one has followed for a
+	 * few symbols, so partial alignments within the preamble lose out.
+	 */
+	if( pending_valid && (pending_age >= peak_hold_samples) ) {
+		detection = pending;
+		detection.offset -= static_cast<int32_t>(pending_age) << 16;
+		pending_valid = false;
+		return true;
+	}
+
+	return false;
+}
+
+} /* namespace dsp */
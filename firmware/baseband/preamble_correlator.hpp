@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PREAMBLE_CORRELATOR_H__
+#define __PREAMBLE_CORRELATOR_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace dsp {
+
+/* Soft-decision preamble correlator for binary symbols at two samples per
+ * symbol. Both sample phases are correlated against the same 16-symbol
+ * level pattern, each with the window mean removed, so a constant offset
+ * (e.g. FSK carrier frequency error) does not degrade detection. A
+ * detection reports the correlation peak with fractional sample timing,
+ * the offset, and the amplitude and polarity of the final symbol.
+ */
+class PreambleCorrelator {
+public:
+	static constexpr size_t symbol_count = 16;
+	static constexpr size_t samples_per_symbol = 2;
+	static constexpr size_t peak_hold_samples = 4 * samples_per_symbol;
+
+	struct Detection {
+		/* Center of the final preamble symbol, relative to the newest
+		 * sample, in Q16 samples (< 0). Detection is reported a few
+		 * symbols after the preamble; see sample() for the history.
+		 */
+		int32_t offset;
+		/* Final preamble symbol, window mean removed. */
+		int32_t symbol;
+		/* Constant offset of the preamble, e.g. FSK carrier frequency
+		 * error at a discriminator output.
+		 */
+		int32_t bias;
+	};
+
+	/* levels: expected symbol levels (1 = positive), oldest symbol most
+	 * significant. Polarity of the received pattern may be inverted.
+	 * threshold: minimum normalized correlation squared, 0.0 to 1.0.
+	 */
+	PreambleCorrelator(
+		const uint32_t levels,
+		const float threshold
+	);
+
+	template<typename DetectionHandler>
+	void operator()(
+		const int16_t sample,
+		DetectionHandler detection_handler
+	) {
+		if( execute(sample) ) {
+			detection_handler(detection);
+		}
+	}
+
+	/* Sample history, age 0 being the newest sample. age < symbol_count * samples_per_symbol. */
+	int32_t sample(const size_t age) const;
+
+private:
+	/* Per phase, oldest sample first, packed for dual MAC. */
+	alignas(4) std::array<std::array<int16_t, symbol_count>, samples_per_symbol> history { };
+	size_t phase { 0 };
+
+	/* Mean-removed pattern, scaled by symbol_count to stay integer. */
+	alignas(4) std::array<int16_t, symbol_count> pattern { };
+	int32_t pattern_symbol_gain { 0 };
+	int32_t last_level { 1 };
+	int32_t level_sum { 0 };
+	int64_t pattern_energy { 0 };
+	/* Threshold, Q8. */
+	int32_t threshold_q8 { 0 };
+
+	struct Candidate {
+		int32_t correlation;
+		int32_t sum;
+		bool valid;
+	};
+
+	std::array<Candidate, 3> candidates { };
+	Detection pending { };
+	int32_t pending_magnitude { 0 };
+	size_t pending_age { 0 };
+	bool pending_valid { false };
+	Detection detection { };
+
+	bool execute(const int16_t sample);
+};
+
+} /* namespace dsp */
+
+#endif/*__PREAMBLE_CORRELATOR_H__*/
@@ -21,12 +21,16 @@
 
 #include "proc_ais.hpp"
 
+#include "ais_packet.hpp"
+
 #include "portapack_shared_memory.hpp"
 
 #include "dsp_fir_taps.hpp"
 
 #include "event_m4.hpp"
 
+#include <algorithm>
+
 AISProcessor::AISProcessor() {
 	decim_0.configure(taps_11k0_decim_0.taps, 33554432);
 	decim_1.configure(taps_11k0_decim_1.taps, 131072);
@@ -44,15 +48,59 @@ void AISProcessor::execute(const buffer_c8_t& buffer) {
 
 	for(size_t i=0; i<decimator_out.count; i++) {
 		if( mf.execute_once(decimator_out.p[i]) ) {
-			clock_recovery(mf.get_output());
+			consume_sample(__SSAT(static_cast<int32_t>(mf.get_output()), 16));
 		}
 	}
+
+	packet_stats.process(buffer, [](const PacketStatistics& statistics) {
+		const PacketStatisticsMessage message { statistics };
+		shared_memory.application_queue.push(message);
+	});
+}
+
+void AISProcessor::consume_sample(const int16_t sample) {
+	/* Symbol timing only runs between a preamble detection and the end of
+	 * the packet. Detections during a packet are ignored.
+	 */
+	if( packet_builder.is_receiving() ) {
+		clock_recovery(sample - symbol_bias, [this](const int32_t symbol) {
+			this->consume_symbol(symbol);
+		});
+	}
+
+	preamble_correlator(sample, [this](const dsp::PreambleCorrelator::Detection& detection) {
+		if( !this->packet_builder.is_receiving() ) {
+			this->start_packet(detection);
+		}
+	});
+}
+
+void AISProcessor::start_packet(const dsp::PreambleCorrelator::Detection& detection) {
+	/* Detection trails the preamble by a few symbols. Restart timing at the
+	 * final preamble symbol and replay the samples since.
+	 */
+	symbol_bias = detection.bias;
+	const size_t replay_count = std::max<int32_t>(0, (-detection.offset >> 16) - 1);
+
+	constexpr auto history_length = decltype(clock_recovery)::history_length;
+	for(size_t n=0; n<history_length; n++) {
+		clock_recovery.skip(preamble_correlator.sample(replay_count + history_length - 1 - n) - symbol_bias);
+	}
+	clock_recovery.align(detection.offset + (static_cast<int32_t>(replay_count) << 16), detection.symbol);
+	nrzi_decode.reset((detection.symbol >= 0) ? 1 : 0);
+	packet_builder.start_payload(0b01111110, 8);
+
+	for(size_t age=replay_count; age>0; age--) {
+		clock_recovery(preamble_correlator.sample(age - 1) - symbol_bias, [this](const int32_t symbol) {
+			this->consume_symbol(symbol);
+		});
+	}
 }
 
 void AISProcessor::consume_symbol(
-	const float raw_symbol
+	const int32_t raw_symbol
 ) {
-	const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
+	const uint_fast8_t sliced_symbol = (raw_symbol >= 0) ? 1 : 0;
 	const auto decoded_symbol = nrzi_decode(sliced_symbol);
 
 	packet_builder.execute(decoded_symbol);
@@ -61,8 +109,23 @@ void AISProcessor::consume_symbol(
 void AISProcessor::payload_handler(
 	const baseband::Packet& packet
 ) {
-	const AISPacketMessage message { packet };
-	shared_memory.application_queue.push(message);
+	/* Only packets that pass length and CRC checks reach the application. */
+	const ais::Packet ais_packet { packet };
+	if( !ais_packet.length_valid() ) {
+		packet_stats.rejected_length();
+		return;
+	}
+	if( !ais_packet.crc_ok() ) {
+		packet_stats.rejected_crc();
+		return;
+	}
+	packet_stats.accepted();
+
+	if( !deduplicator(packet) ) {
+		return;
+	}
+
+	shared_memory.application_queue.emplace<AISPacketMessage>(packet, true, deduplicator.take_repeat_count());
 }
 
 int main() {
@@ -28,11 +28,14 @@
 
 #include "channel_decimator.hpp"
 #include "matched_filter.hpp"
+#include "preamble_correlator.hpp"
 
 #include "clock_recovery.hpp"
 #include "symbol_coding.hpp"
 #include "packet_builder.hpp"
 #include "baseband_packet.hpp"
+#include "packet_stats_collector.hpp"
+#include "packet_deduplicator.hpp"
 
 #include "message.hpp"
 
@@ -64,13 +67,18 @@ private:
 	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
 	dsp::matched_filter::MatchedFilter mf { baseband::ais::square_taps_38k4_1t_p, 2 };
 
-	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
-		19200, 9600, { 0.0555f },
-		[this](const float symbol) { this->consume_symbol(symbol); }
+	/* Training sequence tail and start flag, NRZI encoded. */
+	dsp::PreambleCorrelator preamble_correlator {
+		symbol_coding::nrzi_encode(0b0101010101111110, 16), 0.7f
+	};
+	int32_t symbol_bias { 0 };
+
+	clock_recovery::FixedPointClockRecovery<clock_recovery::CubicInterpolator, clock_recovery::GardnerDetector> clock_recovery {
+		19200, 9600, 0.025f
 	};
 	symbol_coding::NRZIDecoder nrzi_decode { };
-	PacketBuilder<BitPattern, BitPattern, BitPattern> packet_builder {
-		{ 0b0101010101111110, 16, 1 },
+	PacketBuilder<NeverMatch, BitPattern, BitPattern> packet_builder {
+		{ },
 		{ 0b111110, 6 },
 		{ 0b01111110, 8 },
 		[this](const baseband::Packet& packet) {
@@ -78,7 +86,12 @@ private:
 		}
 	};
 
-	void consume_symbol(const float symbol);
+	PacketStatsCollector packet_stats { };
+	PacketDeduplicator deduplicator { 1000 };
+
+	void consume_sample(const int16_t sample);
+	void start_packet(const dsp::PreambleCorrelator::Detection& detection);
+	void consume_symbol(const int32_t symbol);
 	void payload_handler(const baseband::Packet& packet);
 };
 
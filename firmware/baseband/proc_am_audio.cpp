@@ -41,16 +41,14 @@ void NarrowbandAMAudio::execute(const buffer_c8_t& buffer) {
 	feed_channel_stats(channel_out);
 	channel_spectrum.feed(channel_out, channel_filter_pass_f, channel_filter_stop_f);
 
-	auto audio = demodulate(channel_out);
-	audio_compressor.execute_in_place(audio);
-	audio_output.write(audio);
-}
-
-buffer_f32_t NarrowbandAMAudio::demodulate(const buffer_c16_t& channel) {
 	if( modulation_ssb ) {
-		return demod_ssb.execute(channel, audio_buffer);
+		/* SSB/CW level is handled by the demodulator AGC. */
+		const auto audio = demod_ssb.execute(channel_out, audio_s16_buffer);
+		audio_output.write(audio);
 	} else {
-		return demod_am.execute(channel, audio_buffer);
+		auto audio = demod_am.execute(channel_out, audio_buffer);
+		audio_compressor.execute_in_place(audio);
+		audio_output.write(audio);
 	}
 }
 
@@ -90,11 +88,22 @@ void NarrowbandAMAudio::configure(const AMConfigureMessage& message) {
 	decim_0.configure(message.decim_0_filter.taps, 33554432);
 	decim_1.configure(message.decim_1_filter.taps, 131072);
 	decim_2.configure(message.decim_2_filter.taps, decim_2_decimation_factor);
-	channel_filter.configure(message.channel_filter.taps, channel_filter_decimation_factor);
-	channel_filter_pass_f = message.channel_filter.pass_frequency_normalized * channel_filter_input_fs;
-	channel_filter_stop_f = message.channel_filter.stop_frequency_normalized * channel_filter_input_fs;
+	modulation_ssb = (message.modulation != AMConfigureMessage::Modulation::DSB);
+	if( modulation_ssb ) {
+		demod_ssb.configure(
+			channel_filter_input_fs,
+			message.passband_low_hz, message.passband_high_hz, message.bfo_hz,
+			(message.modulation == AMConfigureMessage::Modulation::LSB)
+		);
+		channel_filter.configure(demod_ssb.channel_taps().data(), demod_ssb.channel_taps_count(), channel_filter_decimation_factor);
+		channel_filter_pass_f = demod_ssb.passband_frequency();
+		channel_filter_stop_f = demod_ssb.stop_frequency();
+	} else {
+		channel_filter.configure(message.channel_filter.taps, channel_filter_decimation_factor);
+		channel_filter_pass_f = message.channel_filter.pass_frequency_normalized * channel_filter_input_fs;
+		channel_filter_stop_f = message.channel_filter.stop_frequency_normalized * channel_filter_input_fs;
+	}
 	channel_spectrum.set_decimation_factor(std::floor(channel_filter_output_fs / (channel_filter_pass_f + channel_filter_stop_f)));
-	modulation_ssb = (message.modulation == AMConfigureMessage::Modulation::SSB);
 	audio_output.configure(message.audio_hpf_config);
 
 	configured = true;
@@ -59,6 +59,11 @@ private:
 		audio.data(),
 		audio.size()
 	};
+	std::array<int16_t, 32> audio_s16 { };
+	const buffer_s16_t audio_s16_buffer {
+		audio_s16.data(),
+		audio_s16.size()
+	};
 
 	dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
 	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
@@ -70,7 +75,7 @@ private:
 	bool modulation_ssb = false;
 	dsp::demodulate::AM demod_am { };
 	dsp::demodulate::SSB demod_ssb { };
-	FeedForwardCompressor audio_compressor { };
+	FeedForwardCompressor audio_compressor { 32 };
 	AudioOutput audio_output { };
 
 	SpectrumCollector channel_spectrum { };
@@ -78,8 +83,6 @@ private:
 	bool configured { false };
 	void configure(const AMConfigureMessage& message);
 	void capture_config(const CaptureConfigMessage& message);
-
-	buffer_f32_t demodulate(const buffer_c16_t& channel);
 };
 
 #endif/*__PROC_AM_AUDIO_H__*/
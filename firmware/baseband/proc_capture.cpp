@@ -28,40 +28,81 @@
 #include "utility.hpp"
 
 CaptureProcessor::CaptureProcessor() {
-	const auto& decim_0_filter = taps_200k_decim_0;
-	constexpr size_t decim_0_input_fs = baseband_fs;
-	constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
-
-	const auto& decim_1_filter = taps_200k_decim_1;
-	constexpr size_t decim_1_input_fs = decim_0_output_fs;
-	constexpr size_t decim_1_output_fs = decim_1_input_fs / decim_1.decimation_factor;
+	configure({ 8, CaptureConfigureMessage::Format::C16 });
+}
 
-	decim_0.configure(decim_0_filter.taps, 33554432);
-	decim_1.configure(decim_1_filter.taps, 131072);
+buffer_c16_t CaptureProcessor::decimate(const buffer_c8_t& buffer) {
+	return decimate_2x(decim_0.execute(buffer, dst_buffer), 0);
+}
 
-	channel_filter_pass_f = decim_1_filter.pass_frequency_normalized * decim_1_input_fs;
-	channel_filter_stop_f = decim_1_filter.stop_frequency_normalized * decim_1_input_fs;
+buffer_c16_t CaptureProcessor::decimate_2x(const buffer_c16_t& src, const size_t stage) {
+	if( stage < decim_2x_count ) {
+		return decimate_2x(decim_2x[stage].execute(src, dst_buffer), stage + 1);
+	} else {
+		return src;
+	}
+}
 
-	spectrum_interval_samples = decim_1_output_fs / spectrum_rate_hz;
-	spectrum_samples = 0;
+size_t CaptureProcessor::requantize_c8(const buffer_c16_t& src) {
+	/* Drop 8 bits, adding triangular (TPDF) dither of +/-1 output LSB so
+	 * that signals below the new LSB survive as noise-like error instead of
+	 * being truncated away. One xorshift32 step feeds both components.
+	 */
+	uint32_t r = dither_state;
+	for(size_t i=0; i<src.count; i++) {
+		r ^= r << 13;
+		r ^= r >> 17;
+		r ^= r << 5;
+		const int32_t dither_i = static_cast<int32_t>((r >>  0) & 0xff) - static_cast<int32_t>((r >>  8) & 0xff);
+		const int32_t dither_q = static_cast<int32_t>((r >> 16) & 0xff) - static_cast<int32_t>((r >> 24) & 0xff);
+		const int32_t i_out = (src.p[i].real() + 128 + dither_i) >> 8;
+		const int32_t q_out = (src.p[i].imag() + 128 + dither_q) >> 8;
+		dst_c8[i] = { static_cast<int8_t>(__SSAT(i_out, 8)), static_cast<int8_t>(__SSAT(q_out, 8)) };
+	}
+	dither_state = r;
+	return src.count;
+}
 
-	channel_spectrum.set_decimation_factor(1);
+void CaptureProcessor::write(const void* const data, const size_t length, const uint32_t peak_mag_sq) {
+	if( trigger ) {
+		trigger->feed(*stream, data, length, peak_mag_sq);
+	} else {
+		stream->write(data, length);
+	}
 }
 
 void CaptureProcessor::execute(const buffer_c8_t& buffer) {
-	/* 2.4576MHz, 2048 samples */
-	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-	const auto& decimator_out = decim_1_out;
+	/* 4MHz, 2048 samples */
+	const auto decimator_out = decimate(buffer);
 	const auto& channel = decimator_out;
 
+	const auto peak_mag_sq = feed_channel_stats(channel);
+
 	if( stream ) {
-		const size_t bytes_to_write = sizeof(*decimator_out.p) * decimator_out.count;
-		const auto result = stream->write(decimator_out.p, bytes_to_write);
+		switch(format) {
+		case CaptureConfigureMessage::Format::C8:
+			{
+				const auto count = requantize_c8(decimator_out);
+				write(dst_c8.data(), sizeof(dst_c8[0]) * count, peak_mag_sq);
+			}
+			break;
+
+		case CaptureConfigureMessage::Format::RiceC16:
+			{
+				const auto bytes_to_write = iq_codec::encode(decimator_out.p, decimator_out.count, dst_compressed.data());
+				write(dst_compressed.data(), bytes_to_write, peak_mag_sq);
+			}
+			break;
+
+		default:
+			{
+				const size_t bytes_to_write = sizeof(*decimator_out.p) * decimator_out.count;
+				write(decimator_out.p, bytes_to_write, peak_mag_sq);
+			}
+			break;
+		}
 	}
 
-	feed_channel_stats(channel);
-
 	spectrum_samples += channel.count;
 	if( spectrum_samples >= spectrum_interval_samples ) {
 		spectrum_samples -= spectrum_interval_samples;
@@ -76,6 +117,10 @@ void CaptureProcessor::on_message(const Message* const message) {
 		channel_spectrum.on_message(message);
 		break;
 
+	case Message::ID::CaptureConfigure:
+		configure(*reinterpret_cast<const CaptureConfigureMessage*>(message));
+		break;
+
 	case Message::ID::CaptureConfig:
 		capture_config(*reinterpret_cast<const CaptureConfigMessage*>(message));
 		break;
@@ -85,9 +130,69 @@ void CaptureProcessor::on_message(const Message* const message) {
 	}
 }
 
+void CaptureProcessor::configure(const CaptureConfigureMessage& message) {
+	/* The same decimate-by-2 prototype serves every stage, as its response
+	 * is specified relative to the stage's input rate.
+	 */
+	const auto& decim_0_filter = taps_200k_decim_0;
+	const auto& decim_2x_filter = taps_200k_decim_1;
+
+	decim_2x_count = 0;
+	while( (decim_2x_count < decim_2x.size()) &&
+	       ((decim_0.decimation_factor << decim_2x_count) < message.decimation_factor) ) {
+		decim_2x_count++;
+	}
+
+	decim_0.configure(decim_0_filter.taps, 33554432);
+	for(auto& decim : decim_2x) {
+		decim.configure(decim_2x_filter.taps, 131072);
+	}
+
+	const size_t decim_0_output_fs = baseband_fs / decim_0.decimation_factor;
+	const size_t output_fs = decim_0_output_fs >> decim_2x_count;
+	if( decim_2x_count ) {
+		const size_t last_input_fs = output_fs * 2;
+		channel_filter_pass_f = decim_2x_filter.pass_frequency_normalized * last_input_fs;
+		channel_filter_stop_f = decim_2x_filter.stop_frequency_normalized * last_input_fs;
+	} else {
+		channel_filter_pass_f = decim_0_filter.pass_frequency_normalized * baseband_fs;
+		channel_filter_stop_f = decim_0_filter.stop_frequency_normalized * baseband_fs;
+	}
+
+	format = message.format;
+
+	/* A segment being recorded must not be left open when the trigger is
+	 * replaced, or its data would run into the next segment. Nor may the
+	 * stream go on holding history for a trigger that is gone.
+	 */
+	if( stream && trigger ) {
+		trigger->stop(*stream);
+	}
+
+	if( message.triggered ) {
+		/* Every execute() produces one chunk, 2048 baseband samples long. */
+		constexpr uint32_t chunk_us = 2048ULL * 1000000 / baseband_fs;
+		trigger = std::make_unique<CaptureTrigger>(
+			message.trigger_threshold_db,
+			(message.pre_trigger_ms * 1000 + chunk_us - 1) / chunk_us,
+			(message.post_trigger_ms * 1000 + chunk_us - 1) / chunk_us
+		);
+	} else {
+		trigger.reset();
+	}
+
+	spectrum_interval_samples = output_fs / spectrum_rate_hz;
+	spectrum_samples = 0;
+
+	channel_spectrum.set_decimation_factor(1);
+}
+
 void CaptureProcessor::capture_config(const CaptureConfigMessage& message) {
 	if( message.config ) {
 		stream = std::make_unique<StreamInput>(message.config);
+		if( trigger ) {
+			trigger->reset();
+		}
 	} else {
 		stream.reset();
 	}
@@ -31,6 +31,9 @@
 #include "spectrum_collector.hpp"
 
 #include "stream_input.hpp"
+#include "capture_trigger.hpp"
+
+#include "iq_codec.hpp"
 
 #include <array>
 #include <memory>
@@ -57,18 +60,34 @@ private:
 		dst.size()
 	};
 
+	std::array<complex8_t, 512> dst_c8 { };
+	std::array<uint32_t, iq_codec::block_size_max(512) / sizeof(uint32_t)> dst_compressed { };
+
+	/* decim_0, then decim_2x_count of the decimate-by-2 stages. */
 	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
-	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
+	std::array<dsp::decimate::FIRC16xR16x16Decim2, 3> decim_2x { };
+	size_t decim_2x_count { 1 };
 	uint32_t channel_filter_pass_f = 0;
 	uint32_t channel_filter_stop_f = 0;
 
+	CaptureConfigureMessage::Format format { CaptureConfigureMessage::Format::C16 };
+	uint32_t dither_state { 1 };
+
 	std::unique_ptr<StreamInput> stream { };
+	/* Set when only activity is captured. */
+	std::unique_ptr<CaptureTrigger> trigger { };
 
 	SpectrumCollector channel_spectrum { };
 	size_t spectrum_interval_samples = 0;
 	size_t spectrum_samples = 0;
 
+	void configure(const CaptureConfigureMessage& message);
 	void capture_config(const CaptureConfigMessage& message);
+
+	buffer_c16_t decimate(const buffer_c8_t& buffer);
+	buffer_c16_t decimate_2x(const buffer_c16_t& src, const size_t stage);
+	size_t requantize_c8(const buffer_c16_t& src);
+	void write(const void* const data, const size_t length, const uint32_t peak_mag_sq);
 };
 
 #endif/*__PROC_CAPTURE_HPP__*/
@@ -25,21 +25,44 @@
 
 #include "event_m4.hpp"
 
-float ERTProcessor::abs(const complex8_t& v) {
-	// const int16_t r = v.real() - offset_i;
-	// const int16_t i = v.imag() - offset_q;
-	// const uint32_t r2 = r * r;
-	// const uint32_t i2 = i * i;
-	// const uint32_t r2_i2 = r2 + i2;
-	// return std::sqrt(static_cast<float>(r2_i2));
-	const float r = static_cast<float>(v.real()) - offset_i;
-	const float i = static_cast<float>(v.imag()) - offset_q;
-	const float r2 = r * r;
-	const float i2 = i * i;
-	const float r2_i2 = r2 + i2;
-	return std::sqrt(r2_i2);
+#include <array>
+
+#include <hal.h>
+
+#include <algorithm>
+
+namespace {
+
+constexpr uint32_t isqrt(const uint32_t x) {
+	uint32_t r = 0;
+	while( ((r + 1) * (r + 1)) <= x ) {
+		r++;
+	}
+	return r;
+}
+
+/* round(sqrt(n) * 16) for n in 0..255. */
+constexpr std::array<uint16_t, 256> make_sqrt_table() {
+	std::array<uint16_t, 256> result { };
+	for(size_t n=0; n<result.size(); n++) {
+		result[n] = (isqrt(n * 1024) + 1) / 2;
+	}
+	return result;
+}
+
+constexpr auto sqrt_table = make_sqrt_table();
+
+/* sqrt(x) * 16, from the top seven or eight significant bits of x (shifted
+ * by an even amount) looked up in a table. Within about 0.5%.
+ */
+inline uint32_t sqrt_x16(const uint32_t x) {
+	const int32_t bits = 32 - __CLZ(x);
+	const int32_t shift = std::max<int32_t>(0, bits - 7) & ~1;
+	return sqrt_table[x >> shift] << (shift >> 1);
 }
 
+} /* namespace */
+
 void ERTProcessor::execute(const buffer_c8_t& buffer) {
 	/* 4.194304MHz, 2048 samples */
 
@@ -50,27 +73,37 @@ void ERTProcessor::execute(const buffer_c8_t& buffer) {
 	average_q += src->imag();
 	average_count++;
 	if( average_count == average_window ) {
-		offset_i = static_cast<float>(average_i) / average_window;
-		offset_q = static_cast<float>(average_q) / average_window;
+		/* Offsets as int8 * 256, in both halfwords. */
+		const int32_t offset_i_q8 = average_i * 256 / static_cast<int32_t>(average_window);
+		const int32_t offset_q_q8 = average_q * 256 / static_cast<int32_t>(average_window);
+		offset_i = __PKHBT(offset_i_q8, offset_i_q8, 16);
+		offset_q = __PKHBT(offset_q_q8, offset_q_q8, 16);
 		average_i = 0;
 		average_q = 0;
 		average_count = 0;
 	}
 
-	const float gain = 128 * samples_per_symbol;
-	const float k = 1.0f / gain;
-
 	while(src < src_end) {
-		float sum = 0.0f;
-		for(size_t i=0; i<(samples_per_symbol / 2); i++) {
-			sum += abs(*(src++));
+		/* Two samples per word: I0, Q0, I1, Q1. Each component is moved to
+		 * the top of a halfword (x256), then offset removed and halved, so
+		 * the sum of squares fits a signed word. Magnitudes come out x2048.
+		 */
+		int32_t sum = 0;
+		for(size_t i=0; i<(samples_per_symbol / 4); i++) {
+			const uint32_t iq = *__SIMD32(src)++;
+			const uint32_t i01 = __SHSUB16((iq << 8) & 0xff00ff00, offset_i);
+			const uint32_t q01 = __SHSUB16(iq & 0xff00ff00, offset_q);
+			const uint32_t iq0 = __PKHBT(i01, q01, 16);
+			const uint32_t iq1 = __PKHTB(q01, i01, 16);
+			sum += sqrt_x16(__SMUAD(iq0, iq0));
+			sum += sqrt_x16(__SMUAD(iq1, iq1));
 		}
 		sum_half_period[1] = sum_half_period[0];
 		sum_half_period[0] = sum;
 
 		sum_period[2] = sum_period[1];
 		sum_period[1] = sum_period[0];
-		sum_period[0] = (sum_half_period[0] + sum_half_period[1]) * k;
+		sum_period[0] = sum_half_period[0] + sum_half_period[1];
 
 		manchester[2] = manchester[1];
 		manchester[1] = manchester[0];
@@ -78,30 +111,43 @@ void ERTProcessor::execute(const buffer_c8_t& buffer) {
 
 		const auto data = manchester[0] - manchester[2];
 
-		clock_recovery(data);
+		/* Scaled so a full-scale Manchester difference is about +/-16384. */
+		clock_recovery(data >> 12, [this](const int32_t symbol) {
+			this->consume_symbol(symbol);
+		});
 	}
+
+	symbols.flush(preambles);
+
+	packet_stats.process(buffer, [](const PacketStatistics& statistics) {
+		const PacketStatisticsMessage message { statistics };
+		shared_memory.application_queue.push(message);
+	});
 }
 
 void ERTProcessor::consume_symbol(
-	const float raw_symbol
+	const int32_t raw_symbol
 ) {
-	const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
-	scm_builder.execute(sliced_symbol);
-	idm_builder.execute(sliced_symbol);
+	const uint_fast8_t sliced_symbol = (raw_symbol >= 0) ? 1 : 0;
+	symbols.add(sliced_symbol, preambles);
 }
 
-void ERTProcessor::scm_handler(
+void ERTPacketHandler::operator()(
 	const baseband::Packet& packet
-) {
-	const ERTPacketMessage message { ert::Packet::Type::SCM, packet };
-	shared_memory.application_queue.push(message);
-}
+) const {
+	const ManchesterPacket decoded { packet };
+	const ert::Packet ert_packet { type, decoded };
+	if( !ert_packet.crc_ok() ) {
+		packet_stats.rejected_crc();
+		return;
+	}
+	packet_stats.accepted();
 
-void ERTProcessor::idm_handler(
-	const baseband::Packet& packet
-) {
-	const ERTPacketMessage message { ert::Packet::Type::IDM, packet };
-	shared_memory.application_queue.push(message);
+	if( !deduplicator(decoded, toUType(type)) ) {
+		return;
+	}
+
+	shared_memory.application_queue.emplace_partial<ERTPacketMessage>(type, decoded, true, deduplicator.take_repeat_count(toUType(type)));
 }
 
 int main() {
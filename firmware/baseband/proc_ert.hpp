@@ -32,6 +32,8 @@
 #include "symbol_coding.hpp"
 #include "packet_builder.hpp"
 #include "baseband_packet.hpp"
+#include "packet_stats_collector.hpp"
+#include "packet_deduplicator.hpp"
 
 #include "message.hpp"
 
@@ -50,6 +52,26 @@ constexpr size_t idm_preamble_and_sync_length { 64 - 16 };
 
 constexpr size_t idm_payload_length_max { 1408 };
 
+class ERTPacketHandler {
+public:
+	constexpr ERTPacketHandler(
+		const ert::Packet::Type type,
+		PacketStatsCollector& packet_stats,
+		PacketDeduplicator& deduplicator
+	) : type { type },
+		packet_stats { packet_stats },
+		deduplicator { deduplicator }
+	{
+	}
+
+	void operator()(const baseband::Packet& packet) const;
+
+private:
+	const ert::Packet::Type type;
+	PacketStatsCollector& packet_stats;
+	PacketDeduplicator& deduplicator;
+};
+
 class ERTProcessor : public BasebandProcessor {
 public:
 	void execute(const buffer_c8_t& buffer) override;
@@ -66,45 +88,46 @@ private:
 	BasebandThread baseband_thread { baseband_sampling_rate, this, NORMALPRIO + 20 };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
-	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
-		clock_recovery_rate, symbol_rate, { 1.0f / 18.0f },
-		[this](const float symbol) { this->consume_symbol(symbol); }
+	clock_recovery::FixedPointClockRecovery<clock_recovery::CubicInterpolator, clock_recovery::GardnerDetector> clock_recovery {
+		clock_recovery_rate, symbol_rate, 0.025f
 	};
 
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> scm_builder {
-		{ scm_preamble_and_sync_manchester, scm_preamble_and_sync_length, 1 },
+	PacketStatsCollector packet_stats { };
+	PacketDeduplicator deduplicator { 2000 };
+
+	PacketBuilder<NeverMatch, NeverMatch, FixedLength, ERTPacketHandler> scm_builder {
+		{ },
 		{ },
 		{ scm_payload_length_max },
-		[this](const baseband::Packet& packet) {
-			this->scm_handler(packet);
-		}
+		{ ert::Packet::Type::SCM, packet_stats, deduplicator }
 	};
 
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> idm_builder {
-		{ idm_preamble_and_sync_manchester, idm_preamble_and_sync_length, 1 },
+	PacketBuilder<NeverMatch, NeverMatch, FixedLength, ERTPacketHandler> idm_builder {
+		{ },
 		{ },
 		{ idm_payload_length_max },
-		[this](const baseband::Packet& packet) {
-			this->idm_handler(packet);
-		}
+		{ ert::Packet::Type::IDM, packet_stats, deduplicator }
 	};
 
-	void consume_symbol(const float symbol);
-	void scm_handler(const baseband::Packet& packet);
-	void idm_handler(const baseband::Packet& packet);
+	PreambleMatcherBank<decltype(scm_builder), decltype(idm_builder)> preambles { {
+		BitPattern { scm_preamble_and_sync_manchester, scm_preamble_and_sync_length, 1 },
+		BitPattern { idm_preamble_and_sync_manchester, idm_preamble_and_sync_length, 1 },
+	}, scm_builder, idm_builder };
+
+	SymbolWord symbols { };
 
-	float sum_half_period[2];
-	float sum_period[3];
-	float manchester[3];
+	void consume_symbol(const int32_t symbol);
+
+	int32_t sum_half_period[2] { };
+	int32_t sum_period[3] { };
+	int32_t manchester[3] { };
 
 	const size_t average_window { 2048 };
 	int32_t average_i { 0 };
 	int32_t average_q { 0 };
 	size_t average_count { 0 };
-	float offset_i { 0.0f };
-	float offset_q { 0.0f };
-
-	float abs(const complex8_t& v);
+	uint32_t offset_i { 0 };
+	uint32_t offset_q { 0 };
 };
 
 #endif/*__PROC_ERT_H__*/
@@ -40,6 +40,11 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
 	feed_channel_stats(channel_out);
 	channel_spectrum.feed(channel_out, channel_filter_pass_f, channel_filter_stop_f);
 
+	if( audio_output.is_channel_idle(channel_out) ) {
+		audio_output.write_silence(channel_out.count, channel_out.sampling_rate);
+		return;
+	}
+
 	auto audio = demod.execute(channel_out, audio_buffer);
 	audio_output.write(audio);
 }
@@ -28,6 +28,7 @@
 
 #include "dsp_decimate.hpp"
 #include "dsp_demodulate.hpp"
+#include "dsp_squelch.hpp"
 
 #include "audio_output.hpp"
 #include "spectrum_collector.hpp"
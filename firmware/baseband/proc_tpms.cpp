@@ -41,21 +41,27 @@ void TPMSProcessor::execute(const buffer_c8_t& buffer) {
 
 	for(size_t i=0; i<decimator_out.count; i++) {
 		if( mf_38k4_1t_19k2.execute_once(decimator_out.p[i]) ) {
-			clock_recovery_fsk_19k2(mf_38k4_1t_19k2.get_output());
+			clock_recovery_fsk_19k2(static_cast<int32_t>(mf_38k4_1t_19k2.get_output()), [this](const int32_t raw_symbol) {
+				const uint_fast8_t sliced_symbol = (raw_symbol >= 0) ? 1 : 0;
+				this->symbols_fsk_19k2.add(sliced_symbol, this->packet_builder_fsk_19k2_schrader);
+			});
 		}
 	}
+	symbols_fsk_19k2.flush(packet_builder_fsk_19k2_schrader);
 
 	for(size_t i=0; i<decimator_out.count; i+=channel_decimation) {
 		const auto sliced = ook_slicer_5sps(decimator_out.p[i]);
 		slicer_history = (slicer_history << 1) | sliced;
 
 		clock_recovery_ook_8k192(slicer_history, [this](const bool symbol) {
-			this->packet_builder_ook_8k192_schrader.execute(symbol);
+			this->symbols_ook_8k192.add(symbol, this->packet_builder_ook_8k192_schrader);
 		});
 		clock_recovery_ook_8k4(slicer_history, [this](const bool symbol) {
-			this->packet_builder_ook_8k4_schrader.execute(symbol);
+			this->symbols_ook_8k4.add(symbol, this->packet_builder_ook_8k4_schrader);
 		});
 	}
+	symbols_ook_8k192.flush(packet_builder_ook_8k192_schrader);
+	symbols_ook_8k4.flush(packet_builder_ook_8k4_schrader);
 }
 
 int main() {
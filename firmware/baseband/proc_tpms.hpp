@@ -33,6 +33,7 @@
 #include "symbol_coding.hpp"
 #include "packet_builder.hpp"
 #include "baseband_packet.hpp"
+#include "packet_deduplicator.hpp"
 
 #include "ook.hpp"
 
@@ -57,6 +58,40 @@ constexpr std::array<std::complex<float>, 16> rect_taps_307k2_38k4_1t_19k2_p { {
 	{  0.0000000000e+00f, -6.2500000000e-02f }, {  4.4194173824e-02f, -4.4194173824e-02f },
 } };
 
+class TPMSPacketHandler {
+public:
+	constexpr TPMSPacketHandler(
+		const tpms::SignalType signal_type,
+		PacketDeduplicator& deduplicator
+	) : signal_type { signal_type },
+		deduplicator { deduplicator }
+	{
+	}
+
+	void operator()(const baseband::Packet& packet) const {
+		const ManchesterPacket decoded { packet };
+		/* FSK payloads are 64 to 80 bits in a 160 symbol capture; symbols
+		 * after the end decode as errors and differ between repeats. An
+		 * early error leaves too little to tell packets apart, so such a
+		 * packet is never suppressed.
+		 */
+		const bool fsk = (signal_type == tpms::SignalType::FSK_19k2_Schrader);
+		const size_t compare_count = fsk ? decoded.symbols_before_error() : decoded.symbols_count();
+		if( fsk && (compare_count < fsk_compare_count_min) ) {
+			shared_memory.application_queue.emplace_partial<TPMSPacketMessage>(signal_type, decoded);
+		} else if( deduplicator(decoded, signal_type, compare_count) ) {
+			shared_memory.application_queue.emplace_partial<TPMSPacketMessage>(signal_type, decoded, deduplicator.take_repeat_count(signal_type));
+		}
+	}
+
+private:
+	/* Shortest FSK payload (Schrader). */
+	static constexpr size_t fsk_compare_count_min = 64;
+
+	const tpms::SignalType signal_type;
+	PacketDeduplicator& deduplicator;
+};
+
 class TPMSProcessor : public BasebandProcessor {
 public:
 	TPMSProcessor();
@@ -78,23 +113,19 @@ private:
 	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
 	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
 
+	PacketDeduplicator deduplicator { 1000 };
+
 	dsp::matched_filter::MatchedFilter mf_38k4_1t_19k2 { rect_taps_307k2_38k4_1t_19k2_p, 8 };
 
-	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_19k2 {
-		38400, 19200, { 0.0555f },
-		[this](const float raw_symbol) {
-			const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
-			this->packet_builder_fsk_19k2_schrader.execute(sliced_symbol);
-		}
+	clock_recovery::FixedPointClockRecovery<clock_recovery::CubicInterpolator, clock_recovery::GardnerDetector> clock_recovery_fsk_19k2 {
+		38400, 19200, 0.025f
 	};
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_19k2_schrader {
+	SymbolWord symbols_fsk_19k2 { };
+	PacketBuilder<BitPattern, NeverMatch, FixedLength, TPMSPacketHandler> packet_builder_fsk_19k2_schrader {
 		{ 0b010101010101010101010101010110, 30, 1 },
 		{ },
 		{ 160 },
-		[this](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::FSK_19k2_Schrader, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ tpms::SignalType::FSK_19k2_Schrader, deduplicator }
 	};
 
 	static constexpr float channel_rate_in = 307200.0f;
@@ -107,7 +138,8 @@ private:
 		channel_sample_rate / 8192.0f
 	};
 
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_ook_8k192_schrader {
+	SymbolWord symbols_ook_8k192 { };
+	PacketBuilder<BitPattern, NeverMatch, FixedLength, TPMSPacketHandler> packet_builder_ook_8k192_schrader {
 		/* Preamble: 11*2, 01*14, 11, 10
 		 * Payload: 37 Manchester-encoded bits
 		 * Bit rate: 4096 Hz
@@ -115,17 +147,15 @@ private:
 		{ 0b010101010101010101011110, 24, 0 },
 		{ },
 		{ 37 * 2 },
-		[](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::OOK_8k192_Schrader, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ tpms::SignalType::OOK_8k192_Schrader, deduplicator }
 	};
 
 	OOKClockRecovery clock_recovery_ook_8k4 {
 		channel_sample_rate / 8400.0f
 	};
 
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_ook_8k4_schrader {
+	SymbolWord symbols_ook_8k4 { };
+	PacketBuilder<BitPattern, NeverMatch, FixedLength, TPMSPacketHandler> packet_builder_ook_8k4_schrader {
 		/* Preamble: 01*40, 01, 10, 01, 01
 		 * Payload: 76 Manchester-encoded bits
 		 * Bit rate: 4200 Hz
@@ -133,10 +163,7 @@ private:
 		{ 0b01010101010101010101010101100101, 32, 0 },
 		{ },
 		{ 76 * 2 },
-		[](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::OOK_8k4_Schrader, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ tpms::SignalType::OOK_8k4_Schrader, deduplicator }
 	};
 };
 
@@ -23,10 +23,14 @@
 
 #include "audio_output.hpp"
 
+#include "portapack_shared_memory.hpp"
+
 #include "event_m4.hpp"
 
 #include <cstdint>
 
+#include <hal.h>
+
 void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 	if( !configured ) {
 		return;
@@ -58,18 +62,43 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 	 * -> 192kHz int16_t[128] */
 	auto audio_4fs = audio_dec_1.execute(audio_oversampled, work_audio_buffer);
 
+	/* 192kHz int16_t[128] composite
+	 * -> pilot PLL, 38kHz product detector, stereo blend
+	 * -> 192kHz int16_t[128] L-R (plus products near 76kHz) */
+	auto stereo_4fs = stereo_decoder.execute(audio_4fs, stereo_buffer);
+
+	/* 192kHz int16_t[128] composite
+	 * -> RDS groups (57kHz subcarrier) to application */
+	rds_decoder.execute(audio_4fs);
+
 	/* 192kHz int16_t[128]
 	 * -> 4th order CIC decimation by 2, gain of 1
 	 * -> 96kHz int16_t[64] */
 	auto audio_2fs = audio_dec_2.execute(audio_4fs, work_audio_buffer);
+	auto stereo_2fs = stereo_dec.execute(stereo_4fs, stereo_buffer);
 
-	/* 96kHz int16_t[64]
+	/* 96kHz int16_t[64] L+R, L-R
 	 * -> FIR filter, <15kHz (0.156fs) pass, >19kHz (0.198fs) stop, gain of 1
-	 * -> 48kHz int16_t[32] */
-	auto audio = audio_filter.execute(audio_2fs, work_audio_buffer);
+	 * -> 48kHz int16_t[32] L+R, L-R */
+	const auto audio_count = audio_filter.execute(
+		audio_2fs, stereo_2fs,
+		work_audio_buffer, stereo_buffer
+	);
+
+	/* L = (L+R) + (L-R), R = (L+R) - (L-R) */
+	for(size_t i=0; i<audio_count; i++) {
+		const int32_t sum = work_audio_buffer.p[i];
+		const int32_t difference = stereo_buffer.p[i];
+		audio_left[i] = __SSAT(sum + difference, 16);
+		audio_right[i] = __SSAT(sum - difference, 16);
+	}
 
 	/* -> 48kHz int16_t[32] */
-	audio_output.write(audio);
+	const auto audio_sampling_rate = audio_2fs.sampling_rate / 2;
+	audio_output.write(
+		{ audio_left.data(), audio_count, audio_sampling_rate },
+		{ audio_right.data(), audio_count, audio_sampling_rate }
+	);
 }
 
 void WidebandFMAudio::on_message(const Message* const message) {
@@ -109,6 +138,8 @@ void WidebandFMAudio::configure(const WFMConfigureMessage& message) {
 	channel_filter_pass_f = message.decim_1_filter.pass_frequency_normalized * decim_1_input_fs;
 	channel_filter_stop_f = message.decim_1_filter.stop_frequency_normalized * decim_1_input_fs;
 	demod.configure(demod_input_fs, message.deviation);
+	stereo_decoder.configure(demod_input_fs / 2);
+	rds_decoder.configure(demod_input_fs / 2);
 	audio_filter.configure(message.audio_filter.taps);
 	audio_output.configure(message.audio_hpf_config, message.audio_deemph_config);
 
@@ -125,6 +156,11 @@ void WidebandFMAudio::capture_config(const CaptureConfigMessage& message) {
 	}
 }
 
+void WidebandFMAudio::rds_group_handler(const rds::Group& group) {
+	const RDSGroupMessage message { group };
+	shared_memory.application_queue.push(message);
+}
+
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<WidebandFMAudio>() };
 	event_dispatcher.run();
@@ -28,6 +28,9 @@
 
 #include "dsp_decimate.hpp"
 #include "dsp_demodulate.hpp"
+#include "dsp_stereo.hpp"
+
+#include "rds_decoder.hpp"
 
 #include "audio_output.hpp"
 #include "spectrum_collector.hpp"
@@ -54,6 +57,13 @@ private:
 		(int16_t*)dst.data(),
 		sizeof(dst) / sizeof(int16_t)
 	};
+	std::array<int16_t, 128> stereo { };
+	const buffer_s16_t stereo_buffer {
+		stereo.data(),
+		stereo.size()
+	};
+	std::array<int16_t, 32> audio_left { };
+	std::array<int16_t, 32> audio_right { };
 
 	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
 	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
@@ -63,7 +73,14 @@ private:
 	dsp::demodulate::FM demod { };
 	dsp::decimate::DecimateBy2CIC4Real audio_dec_1 { };
 	dsp::decimate::DecimateBy2CIC4Real audio_dec_2 { };
-	dsp::decimate::FIR64AndDecimateBy2Real audio_filter { };
+	dsp::stereo::Decoder stereo_decoder { };
+	dsp::decimate::DecimateBy2CIC4Real stereo_dec { };
+	dsp::decimate::FIR64AndDecimateBy2RealDual audio_filter { };
+	rds::Decoder rds_decoder {
+		[this](const rds::Group& group) {
+			this->rds_group_handler(group);
+		}
+	};
 
 	AudioOutput audio_output { };
 
@@ -74,6 +91,7 @@ private:
 	bool configured { false };
 	void configure(const WFMConfigureMessage& message);
 	void capture_config(const CaptureConfigMessage& message);
+	void rds_group_handler(const rds::Group& group);
 };
 
 #endif/*__PROC_WFM_AUDIO_H__*/
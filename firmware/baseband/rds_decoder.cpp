@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "rds_decoder.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include <hal.h>
+
+namespace rds {
+
+namespace {
+
+/* g(x) = x^10 + x^8 + x^7 + x^5 + x^4 + x^3 + 1 */
+constexpr uint32_t check_polynomial = 0x5b9;
+constexpr size_t check_bits = 10;
+
+/* Offset words A, B, C, C', D. Offset is added to the check word, so the
+ * syndrome (remainder) of an error-free block is its offset word.
+ */
+constexpr std::array<uint16_t, 5> offset_words { { 0x0fc, 0x198, 0x168, 0x350, 0x1b4 } };
+constexpr std::array<size_t, 5> offset_block_index { { 0, 1, 2, 2, 3 } };
+
+constexpr uint16_t syndrome(const uint32_t block) {
+	uint32_t r = block;
+	for(size_t i=25; i>=check_bits; i--) {
+		if( r & (1U << i) ) {
+			r ^= check_polynomial << (i - check_bits);
+		}
+	}
+	return r;
+}
+
+constexpr std::array<uint16_t, 26> make_bit_syndromes() {
+	std::array<uint16_t, 26> result { };
+	for(size_t i=0; i<result.size(); i++) {
+		result[i] = syndrome(1U << i);
+	}
+	return result;
+}
+
+/* Syndrome of a single bit error at each position. Syndromes are linear,
+ * so a burst's syndrome is the XOR of its bits' syndromes.
+ */
+constexpr std::array<uint16_t, 26> bit_syndromes = make_bit_syndromes();
+
+bool block_valid(const uint32_t block, const size_t block_index) {
+	const auto s = syndrome(block);
+	for(size_t i=0; i<offset_words.size(); i++) {
+		if( (offset_block_index[i] == block_index) && (s == offset_words[i]) ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool block_correct(uint32_t& block, const size_t block_index) {
+	const auto s = syndrome(block);
+	for(size_t i=0; i<offset_words.size(); i++) {
+		if( offset_block_index[i] != block_index ) {
+			continue;
+		}
+
+		const uint16_t error = s ^ offset_words[i];
+		for(size_t n=0; n<bit_syndromes.size(); n++) {
+			if( bit_syndromes[n] == error ) {
+				block ^= (1U << n);
+				return true;
+			}
+		}
+		for(size_t n=0; n<(bit_syndromes.size() - 1); n++) {
+			if( (bit_syndromes[n] ^ bit_syndromes[n + 1]) == error ) {
+				block ^= (3U << n);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+} /* namespace */
+
+void GroupDecoder::acquire_sync() {
+	const auto s = syndrome(block_reg);
+	for(size_t i=0; i<offset_words.size(); i++) {
+		if( s != offset_words[i] ) {
+			continue;
+		}
+
+		const auto block_index = offset_block_index[i];
+		const uint32_t bits_since = bit_count - sync_candidate_bit_count;
+		const size_t blocks_since = bits_since / block_bits;
+		if( sync_candidate_valid &&
+			((bits_since % block_bits) == 0) &&
+			(blocks_since > 0) && (blocks_since <= 4) &&
+			(((sync_candidate_index + blocks_since) & 3) == block_index)
+		) {
+			synchronized = true;
+			block_bit_count = 0;
+			next_block_index = (block_index + 1) & 3;
+			bad_block_count = 0;
+			group_valid = false;
+		}
+
+		sync_candidate_valid = true;
+		sync_candidate_bit_count = bit_count;
+		sync_candidate_index = block_index;
+		break;
+	}
+}
+
+bool GroupDecoder::consume_block() {
+	const auto block_index = next_block_index;
+	next_block_index = (next_block_index + 1) & 3;
+
+	uint32_t block = block_reg;
+	bool corrected = false;
+	bool valid = block_valid(block, block_index);
+	if( !valid ) {
+		valid = corrected = block_correct(block, block_index);
+	}
+
+	if( valid ) {
+		bad_block_count = 0;
+	} else {
+		bad_block_count++;
+		if( bad_block_count > max_bad_blocks ) {
+			synchronized = false;
+			sync_candidate_valid = false;
+		}
+	}
+
+	if( block_index == 0 ) {
+		group_valid = valid;
+		group.corrected_blocks = 0;
+	} else {
+		group_valid = group_valid && valid;
+	}
+
+	if( valid ) {
+		group.blocks[block_index] = block >> check_bits;
+		if( corrected ) {
+			group.corrected_blocks |= (1U << block_index);
+		}
+	}
+
+	return (block_index == 3) && group_valid;
+}
+
+/* Hamming window, n of count. */
+static float hamming(const size_t n, const size_t count) {
+	return 0.54f - 0.46f * std::cos(2.0f * pi * n / (count - 1));
+}
+
+void Decoder::configure(const uint32_t sampling_rate) {
+	/* Windowed-sinc anti-alias low-pass, premultiplied by the oscillator.
+	 * Taps sum to 1 << 15 == 1.0. The filter is symmetric, so taps are
+	 * applied to the buffer oldest sample first.
+	 */
+	std::array<float, mixer_taps_count> mixer_taps_f;
+	const float mixer_fc = mixer_cutoff / sampling_rate;
+	float mixer_taps_sum = 0.0f;
+	for(size_t n=0; n<mixer_taps_count; n++) {
+		const float m = static_cast<float>(n) - (mixer_taps_count - 1) * 0.5f;
+		const float sinc = (m == 0.0f) ? (2.0f * mixer_fc) : (std::sin(2.0f * pi * mixer_fc * m) / (pi * m));
+		mixer_taps_f[n] = sinc * hamming(n, mixer_taps_count);
+		mixer_taps_sum += mixer_taps_f[n];
+	}
+
+	const float lo_phase_inc = 2.0f * pi * subcarrier_frequency / sampling_rate;
+	for(size_t phase=0; phase<mixer_phases; phase++) {
+		for(size_t n=0; n<mixer_taps_count; n+=2) {
+			std::array<int32_t, 2> c;
+			std::array<int32_t, 2> s;
+			for(size_t k=0; k<2; k++) {
+				const size_t lo_index = (phase * mixer_decimation + n + k) % lo_period;
+				const float lo_phase = lo_phase_inc * lo_index;
+				const float tap = mixer_taps_f[n + k] / mixer_taps_sum * 32768.0f;
+				c[k] = std::lround(tap * std::cos(lo_phase));
+				s[k] = std::lround(tap * -std::sin(lo_phase));
+			}
+			mixer_taps_i[phase][n / 2] = __PKHBT(c[0], c[1], 16);
+			mixer_taps_q[phase][n / 2] = __PKHBT(s[0], s[1], 16);
+		}
+	}
+	mixer_phase = 0;
+	mixer_buffer.fill(0);
+
+	/* Matched to the RDS data shaping, H(f) = cos(pi * f * td / 4) for
+	 * |f| <= 2 / td, where td is the bit period. With a = pi * td / 4,
+	 * f0 = 2 / td and b = 2 * pi * t, the impulse response is
+	 * 2a cos(b f0) / (a^2 - b^2), which is f0 at |b| == a.
+	 * Normalized to 1 << 16 == 1.0.
+	 */
+	const float baseband_fs = static_cast<float>(sampling_rate) / mixer_decimation;
+	constexpr float td = 2.0f / symbol_rate;
+	constexpr float a = pi * td / 4.0f;
+	constexpr float f0 = 2.0f / td;
+	constexpr size_t taps_count = dsp::decimate::FIR64AndDecimateBy2RealDual::taps_count;
+	std::array<float, taps_count> taps_f;
+	float taps_sum = 0.0f;
+	for(size_t n=0; n<taps_count; n++) {
+		const float t = (static_cast<float>(n) - (taps_count - 1) * 0.5f) / baseband_fs;
+		const float b = 2.0f * pi * t;
+		const float denominator = a * a - b * b;
+		const float h = (std::abs(denominator) < (a * a * 1e-6f)) ? f0 : (2.0f * a * std::cos(b * f0) / denominator);
+		taps_f[n] = h * hamming(n, taps_count);
+		taps_sum += taps_f[n];
+	}
+	std::array<int16_t, taps_count> taps;
+	for(size_t n=0; n<taps_count; n++) {
+		taps[n] = std::lround(taps_f[n] / taps_sum * 65536.0f);
+	}
+	baseband_filter.configure(taps);
+
+	const float symbol_fs = baseband_fs / 2;
+	/* BPSK axis estimate time constant: 20ms. */
+	axis_alpha = 1.0f / (0.020f * symbol_fs);
+	axis_re = axis_im = 0.0f;
+
+	clock_recovery.configure(symbol_fs, symbol_rate, { 1.0f / 16.0f });
+}
+
+void Decoder::execute(const buffer_s16_t& src) {
+	/* 192kHz int16_t[128] composite
+	 * -> mix with 57kHz, 12kHz low-pass, decimate by 8
+	 * -> 24kHz complex int16_t[16] */
+	const size_t count = std::min(src.count, block_size_max) / mixer_decimation;
+	const size_t src_count = count * mixer_decimation;
+	std::copy(&src.p[0], &src.p[src_count], &mixer_buffer[mixer_history_count]);
+
+	for(size_t n=0; n<count; n++) {
+		const uint32_t* x = reinterpret_cast<const uint32_t*>(&mixer_buffer[n * mixer_decimation]);
+		const auto& taps_i = mixer_taps_i[mixer_phase];
+		const auto& taps_q = mixer_taps_q[mixer_phase];
+		int32_t i_acc = 0;
+		int32_t q_acc = 0;
+		for(size_t k=0; k<mixer_taps_count/2; k++) {
+			i_acc = __SMLAD(x[k], taps_i[k], i_acc);
+			q_acc = __SMLAD(x[k], taps_q[k], q_acc);
+		}
+		mixer_phase = (mixer_phase + 1) & (mixer_phases - 1);
+		i_buffer[n] = __SSAT(i_acc >> 14, 16);
+		q_buffer[n] = __SSAT(q_acc >> 14, 16);
+	}
+
+	std::copy(&mixer_buffer[src_count], &mixer_buffer[src_count + mixer_history_count], &mixer_buffer[0]);
+
+	/* 24kHz complex int16_t[16]
+	 * -> RDS matched filter, decimate by 2
+	 * -> 12kHz complex int16_t[8] */
+	const uint32_t baseband_fs = src.sampling_rate / mixer_decimation;
+	const buffer_s16_t i_in { i_buffer.data(), count, baseband_fs };
+	const buffer_s16_t q_in { q_buffer.data(), count, baseband_fs };
+	const auto baseband_count = baseband_filter.execute(i_in, q_in, i_in, q_in);
+
+	for(size_t n=0; n<baseband_count; n++) {
+		consume_baseband(i_buffer[n], q_buffer[n]);
+	}
+}
+
+void Decoder::consume_baseband(const int16_t i, const int16_t q) {
+	const float re = i;
+	const float im = q;
+
+	/* Squaring removes BPSK modulation, leaving twice the carrier phase. */
+	axis_re += axis_alpha * ((re * re - im * im) - axis_re);
+	axis_im += axis_alpha * ((2.0f * re * im) - axis_im);
+
+	/* Half-angle of the squared carrier: direction of (|v| + re(v), im(v)). */
+	const float axis_mag = std::sqrt(axis_re * axis_re + axis_im * axis_im);
+	float u_re = axis_mag + axis_re;
+	float u_im = axis_im;
+	if( (u_re + std::abs(u_im)) <= (axis_mag * 1e-3f) ) {
+		u_re = 0.0f;
+		u_im = 1.0f;
+	}
+
+	clock_recovery(re * u_re + im * u_im);
+}
+
+void Decoder::consume_symbol(const float symbol) {
+	/* Biphase: each bit is a symbol pair of opposite sign. Track which
+	 * symbol pairing shows larger transitions and decode on that pairing.
+	 */
+	constexpr float energy_decay = 0.98f;
+
+	const float difference = last_symbol - symbol;
+	last_symbol = symbol;
+
+	biphase_energy[symbol_phase] = biphase_energy[symbol_phase] * energy_decay + std::abs(difference);
+	const auto other_phase = symbol_phase ^ 1;
+	if( biphase_energy[other_phase] > (biphase_energy[biphase_phase] * 1.2f) ) {
+		biphase_phase = other_phase;
+	}
+
+	if( symbol_phase == biphase_phase ) {
+		consume_bit((difference > 0.0f) ? 1 : 0);
+	}
+
+	symbol_phase = other_phase;
+}
+
+void Decoder::consume_bit(const uint_fast8_t bit) {
+	const auto decoded_bit = differential_decode(bit);
+	group_decoder(decoded_bit,
+		[this](const Group& group) {
+			/* Forward program service name, radiotext and clock time. */
+			const auto type = group.group_type();
+			const bool wanted = (type == 0) || (type == 2) || ((type == 4) && !group.version_b());
+			// NOTE: This check is to avoid std::function nullptr check, which
+			// brings in "_ZSt25__throw_bad_function_callv" and a lot of extra code.
+			if( wanted && this->group_handler ) {
+				this->group_handler(group);
+			}
+		}
+	);
+}
+
+} /* namespace rds */
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __RDS_DECODER_H__
+#define __RDS_DECODER_H__
+
+#include "dsp_types.hpp"
+#include "dsp_decimate.hpp"
+
+#include "clock_recovery.hpp"
+#include "symbol_coding.hpp"
+
+#include "rds_group.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <functional>
+
+namespace rds {
+
+/* Finds block boundaries in the RDS bit stream by check word syndrome,
+ * corrects burst errors of up to two bits once synchronized, and assembles
+ * groups from consecutive valid blocks A, B, C/C', D.
+ */
+class GroupDecoder {
+public:
+	template<typename GroupHandler>
+	void operator()(
+		const uint_fast8_t bit,
+		GroupHandler group_handler
+	) {
+		block_reg = ((block_reg << 1) | (bit & 1)) & block_mask;
+		bit_count++;
+
+		if( synchronized ) {
+			block_bit_count++;
+			if( block_bit_count == block_bits ) {
+				block_bit_count = 0;
+				if( consume_block() ) {
+					group_handler(group);
+				}
+			}
+		} else {
+			acquire_sync();
+		}
+	}
+
+private:
+	static constexpr size_t block_bits = 26;
+	static constexpr uint32_t block_mask = (1U << block_bits) - 1;
+	static constexpr size_t max_bad_blocks = 10;
+
+	uint32_t block_reg { 0 };
+	uint32_t bit_count { 0 };
+
+	bool synchronized { false };
+	size_t block_bit_count { 0 };
+	size_t next_block_index { 0 };
+	size_t bad_block_count { 0 };
+
+	bool sync_candidate_valid { false };
+	uint32_t sync_candidate_bit_count { 0 };
+	size_t sync_candidate_index { 0 };
+
+	Group group { };
+	bool group_valid { false };
+
+	void acquire_sync();
+	bool consume_block();
+};
+
+/* Recovers RDS groups from an FM composite (MPX) signal at 192kHz:
+ * 57kHz complex downmix through a 32 tap anti-alias low-pass and decimation
+ * by 8 (dual MAC against oscillator-premultiplied taps), filtering matched
+ * to the RDS data shaping and decimation by 2 (dual-channel FIR), BPSK axis
+ * estimate, symbol timing recovery at 2375 symbols/s, biphase and
+ * differential decoding, then block sync.
+ *
+ * The matched filter passes one biphase half-symbol. Differencing the two
+ * halves of each bit completes the biphase matched filter.
+ */
+class Decoder {
+public:
+	using GroupHandlerFunc = std::function<void(const Group& group)>;
+
+	Decoder(
+		GroupHandlerFunc group_handler
+	) : group_handler { std::move(group_handler) }
+	{
+	}
+
+	/* Composite sampling rate must be 192kHz. */
+	void configure(const uint32_t sampling_rate);
+
+	/* src.count must be a multiple of mixer_decimation. */
+	void execute(const buffer_s16_t& src);
+
+private:
+	static constexpr uint32_t subcarrier_frequency = 57000;
+	static constexpr uint32_t symbol_rate = 2375;
+	/* Rejects 21.6-26.4kHz from the subcarrier by 43dB or more, where the
+	 * L-R band would alias onto RDS.
+	 */
+	static constexpr float mixer_cutoff = 12000.0f;
+	static constexpr size_t mixer_taps_count = 32;
+	static constexpr size_t mixer_decimation = 8;
+	/* 57kHz at 192kHz repeats exactly every 64 samples (19 cycles). */
+	static constexpr size_t lo_period = 64;
+	static constexpr size_t mixer_phases = lo_period / mixer_decimation;
+	static constexpr size_t block_size_max = 128;
+	static constexpr size_t mixer_history_count = mixer_taps_count - mixer_decimation;
+
+	/* Anti-alias taps times the oscillator, one set for each oscillator
+	 * phase an output can start on, as pairs packed for SMLAD.
+	 */
+	std::array<std::array<uint32_t, mixer_taps_count / 2>, mixer_phases> mixer_taps_i { };
+	std::array<std::array<uint32_t, mixer_taps_count / 2>, mixer_phases> mixer_taps_q { };
+	size_t mixer_phase { 0 };
+	alignas(4) std::array<int16_t, mixer_history_count + block_size_max> mixer_buffer { };
+
+	std::array<int16_t, block_size_max / mixer_decimation> i_buffer { };
+	std::array<int16_t, block_size_max / mixer_decimation> q_buffer { };
+	dsp::decimate::FIR64AndDecimateBy2RealDual baseband_filter { };
+
+	float axis_re { 0.0f };
+	float axis_im { 0.0f };
+	float axis_alpha { 0.0f };
+
+	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
+		[this](const float symbol) { this->consume_symbol(symbol); }
+	};
+
+	float last_symbol { 0.0f };
+	std::array<float, 2> biphase_energy { };
+	size_t symbol_phase { 0 };
+	size_t biphase_phase { 0 };
+
+	symbol_coding::DifferentialDecoder differential_decode { };
+	GroupDecoder group_decoder { };
+
+	const GroupHandlerFunc group_handler;
+
+	void consume_baseband(const int16_t i, const int16_t q);
+	void consume_symbol(const float symbol);
+	void consume_bit(const uint_fast8_t bit);
+};
+
+} /* namespace rds */
+
+#endif/*__RDS_DECODER_H__*/
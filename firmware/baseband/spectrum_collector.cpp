@@ -135,19 +135,22 @@ void SpectrumCollector::update() {
 		/* Decimated buffer is full. Compute spectrum. */
 		fft_c_preswapped(channel_spectrum);
 
-		ChannelSpectrum spectrum;
-		spectrum.sampling_rate = channel_spectrum_sampling_rate;
-		spectrum.channel_filter_pass_frequency = channel_filter_pass_frequency;
-		spectrum.channel_filter_stop_frequency = channel_filter_stop_frequency;
-		for(size_t i=0; i<spectrum.db.size(); i++) {
-			const auto corrected_sample = spectrum_window_hamming_3(channel_spectrum, i);
-			const auto mag2 = magnitude_squared(corrected_sample * (1.0f / 32768.0f));
-			const float db = mag2_to_dbv_norm(mag2);
-			constexpr float mag_scale = 5.0f;
-			const unsigned int v = (db * mag_scale) + 255.0f;
-			spectrum.db[i] = std::max(0U, std::min(255U, v));
+		/* Build the spectrum directly in the FIFO slot, if one is free. */
+		ChannelSpectrum* const spectrum = fifo.reserve();
+		if( spectrum ) {
+			spectrum->sampling_rate = channel_spectrum_sampling_rate;
+			spectrum->channel_filter_pass_frequency = channel_filter_pass_frequency;
+			spectrum->channel_filter_stop_frequency = channel_filter_stop_frequency;
+			for(size_t i=0; i<spectrum->db.size(); i++) {
+				const auto corrected_sample = spectrum_window_hamming_3(channel_spectrum, i);
+				const auto mag2 = magnitude_squared(corrected_sample * (1.0f / 32768.0f));
+				const float db = mag2_to_dbv_norm(mag2);
+				constexpr float mag_scale = 5.0f;
+				const unsigned int v = (db * mag_scale) + 255.0f;
+				spectrum->db[i] = std::max(0U, std::min(255U, v));
+			}
+			fifo.commit();
 		}
-		fifo.in(spectrum);
 	}
 
 	channel_spectrum_request_update = false;
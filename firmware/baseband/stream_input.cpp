@@ -21,12 +21,14 @@
 
 #include "stream_input.hpp"
 
-#include "lpc43xx_cpp.hpp"
-using namespace lpc43xx;
+#include "event_moderator.hpp"
+
+#include <algorithm>
 
 StreamInput::StreamInput(CaptureConfig* const config) :
 	fifo_buffers_empty { buffers_empty.data(), buffer_count_max_log2 },
 	fifo_buffers_full { buffers_full.data(), buffer_count_max_log2 },
+	fifo_buffers_held { buffers_held.data(), buffer_count_max_log2 },
 	config { config },
 	data { std::make_unique<uint8_t[]>(config->write_size * config->buffer_count) }
 {
@@ -44,9 +46,14 @@ size_t StreamInput::write(const void* const data, const size_t length) {
 	size_t written = 0;
 
 	while( written < length ) {
+		if( segment_end_pending && !submit_segment_end() ) {
+			// Data must not land in the segment that has ended.
+			break;
+		}
+
 		if( !active_buffer ) {
 			// We need an empty buffer...
-			if( !fifo_buffers_empty.out(active_buffer) ) {
+			if( !take_empty_buffer() ) {
 				// ...but none are available. Samples were dropped.
 				break;
 			}
@@ -56,7 +63,9 @@ size_t StreamInput::write(const void* const data, const size_t length) {
 		written += active_buffer->write(&p[written], remaining);
 
 		if( active_buffer->is_full() ) {
-			if( !fifo_buffers_full.in(active_buffer) ) {
+			if( holding ) {
+				hold_active_buffer();
+			} else if( !submit_active_buffer() ) {
 				// FIFO is full of buffers, there's no place for this one.
 				// Bail out of the loop, and try submitting the buffer in the
 				// next pass.
@@ -64,8 +73,6 @@ size_t StreamInput::write(const void* const data, const size_t length) {
 				// than the capacity of the FIFO.
 				break;
 			}
-			active_buffer = nullptr;
-			creg::m4txevent::assert_event();
 		}
 	}
 
@@ -74,3 +81,107 @@ size_t StreamInput::write(const void* const data, const size_t length) {
 
 	return written;
 }
+
+void StreamInput::end_segment() {
+	segment_end_pending = true;
+	submit_segment_end();
+}
+
+void StreamInput::hold_history() {
+	holding = true;
+}
+
+void StreamInput::release_history(const size_t length) {
+	holding = false;
+
+	/* Data older than length is dropped: whole buffers go back to the held
+	 * queue empty, to be reused first, and the oldest buffer kept is
+	 * trimmed at the front.
+	 */
+	size_t excess = history_size() - std::min(length, history_size());
+	bool submitted = false;
+	for(size_t n=fifo_buffers_held.len(); n>0; n--) {
+		StreamBuffer* buffer;
+		fifo_buffers_held.out(buffer);
+		held_size -= buffer->size();
+
+		if( excess >= buffer->size() ) {
+			excess -= buffer->size();
+			buffer->empty();
+			fifo_buffers_held.in(buffer);
+		} else {
+			buffer->trim_front(excess);
+			excess = 0;
+			/* Can't fail, the FIFO has room for every buffer. */
+			fifo_buffers_full.in(buffer);
+			submitted = true;
+		}
+	}
+
+	if( active_buffer ) {
+		active_buffer->trim_front(excess);
+	}
+
+	if( submitted ) {
+		m4_event_moderator.post_immediate();
+	}
+}
+
+size_t StreamInput::history_size() const {
+	return held_size + (active_buffer ? active_buffer->size() : 0);
+}
+
+bool StreamInput::take_empty_buffer() {
+	/* While holding, one buffer is kept out of the history so the data that
+	 * trips the trigger has somewhere to go. Past that, the oldest held
+	 * buffer is reused, losing the history it holds.
+	 */
+	const bool history_full = holding && ((fifo_buffers_held.len() + 1) >= config->buffer_count);
+	if( !history_full && fifo_buffers_empty.out(active_buffer) ) {
+		return true;
+	}
+
+	if( fifo_buffers_held.out(active_buffer) ) {
+		held_size -= active_buffer->size();
+		active_buffer->empty();
+		return true;
+	}
+
+	return fifo_buffers_empty.out(active_buffer);
+}
+
+void StreamInput::hold_active_buffer() {
+	/* Can't fail, the FIFO has room for every buffer. */
+	fifo_buffers_held.in(active_buffer);
+	held_size += active_buffer->size();
+	active_buffer = nullptr;
+}
+
+bool StreamInput::submit_active_buffer() {
+	if( !fifo_buffers_full.in(active_buffer) ) {
+		return false;
+	}
+	active_buffer = nullptr;
+	/* The M0 must return buffers promptly; the pool is small. */
+	m4_event_moderator.post_immediate();
+	return true;
+}
+
+bool StreamInput::submit_segment_end() {
+	/* With no buffer in progress, the marker goes out on an empty one. If
+	 * none is free, try again on the next write.
+	 */
+	if( !active_buffer ) {
+		if( !take_empty_buffer() ) {
+			return false;
+		}
+	}
+
+	active_buffer->set_segment_end();
+	if( !submit_active_buffer() ) {
+		return false;
+	}
+
+	segment_end_pending = false;
+	return true;
+}
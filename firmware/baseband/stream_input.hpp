@@ -41,18 +41,43 @@ public:
 
 	size_t write(const void* const data, const size_t length);
 
+	/* Hands over the partly filled buffer, marked as the end of a segment. */
+	void end_segment();
+
+	/* Pre-trigger history. While holding, full buffers are kept back instead
+	 * of being handed over, and the oldest is reused once only one other
+	 * buffer is left. Given the buffers back from the M0, the history is at
+	 * least buffer_count - 2 buffers deep. release_history() hands over the
+	 * newest length bytes of it and stops holding.
+	 */
+	void hold_history();
+	void release_history(const size_t length);
+
+	/* Data currently held, including the buffer being filled. */
+	size_t history_size() const;
+
 private:
-	static constexpr size_t buffer_count_max_log2 = 3;
-	static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
+	static constexpr size_t buffer_count_max_log2 = CaptureConfig::buffer_count_max_log2;
+	static constexpr size_t buffer_count_max = CaptureConfig::buffer_count_max;
 	
 	FIFO<StreamBuffer*> fifo_buffers_empty;
 	FIFO<StreamBuffer*> fifo_buffers_full;
+	FIFO<StreamBuffer*> fifo_buffers_held;
 	std::array<StreamBuffer, buffer_count_max> buffers { };
 	std::array<StreamBuffer*, buffer_count_max> buffers_empty { };
 	std::array<StreamBuffer*, buffer_count_max> buffers_full { };
+	std::array<StreamBuffer*, buffer_count_max> buffers_held { };
 	StreamBuffer* active_buffer { nullptr };
+	bool segment_end_pending { false };
+	bool holding { false };
+	size_t held_size { 0 };
 	CaptureConfig* const config { nullptr };
 	std::unique_ptr<uint8_t[]> data { };
+
+	bool take_empty_buffer();
+	bool submit_active_buffer();
+	void hold_active_buffer();
+	bool submit_segment_end();
 };
 
 #endif/*__STREAM_INPUT_H__*/
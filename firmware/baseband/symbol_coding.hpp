@@ -35,6 +35,37 @@ public:
 		return out;
 	}
 
+	void reset(const uint_fast8_t symbol) {
+		last = symbol & 1;
+	}
+
+private:
+	uint_fast8_t last { 0 };
+};
+
+/* NRZI levels (1 = high) for count bits, oldest bit most significant,
+ * starting after a high level.
+ */
+constexpr uint32_t nrzi_encode(const uint32_t bits, const size_t count) {
+	uint32_t levels = 0;
+	uint32_t level = 1;
+	for(size_t i=0; i<count; i++) {
+		if( ((bits >> (count - 1 - i)) & 1) == 0 ) {
+			level ^= 1;
+		}
+		levels = (levels << 1) | level;
+	}
+	return levels;
+}
+
+class DifferentialDecoder {
+public:
+	uint_fast8_t operator()(const uint_fast8_t symbol) {
+		const auto out = (symbol ^ last) & 1;
+		last = symbol;
+		return out;
+	}
+
 private:
 	uint_fast8_t last { 0 };
 };
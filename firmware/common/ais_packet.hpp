@@ -98,15 +98,18 @@ using MMSI = uint32_t;
 class Packet {
 public:
 	constexpr Packet(
-		const baseband::Packet& packet
+		const baseband::Packet& packet,
+		const bool validated = false
 	) : packet_ { packet },
-		field_ { packet_ }
+		field_ { packet_ },
+		validated_ { validated }
 	{
 	}
 
 	size_t length() const;
 	
 	bool is_valid() const;
+	bool length_valid() const;
 
 	Timestamp received_at() const;
 
@@ -131,13 +134,13 @@ private:
 	
 	const baseband::Packet packet_;
 	const Reader field_;
+	/* Length and CRC already checked by the baseband. */
+	const bool validated_;
 
 	const size_t fcs_length = 16;
 
 	size_t data_and_fcs_length() const;
 	size_t data_length() const;
-
-	bool length_valid() const;
 };
 
 } /* namespace ais */
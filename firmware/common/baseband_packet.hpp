@@ -24,8 +24,10 @@
 
 #include "baseband.hpp"
 
+#include <cstdint>
 #include <cstddef>
-#include <bitset>
+#include <array>
+#include <algorithm>
 
 namespace baseband {
 
@@ -41,12 +43,42 @@ public:
 
 	void add(const bool symbol) {
 		if( count < capacity() ) {
-			data[count++] = symbol;
+			if( symbol ) {
+				data[count / word_bits] |= (1U << (word_bits - 1 - (count % word_bits)));
+			}
+			count++;
 		}
 	}
 
+	/* Append the low n (1 to 32) bits of symbols, oldest symbol in the
+	 * most significant position, as shifted into a history register.
+	 */
+	void add_bits(const uint32_t symbols, const size_t n) {
+		const size_t n_added = std::min(n, capacity() - count);
+		if( n_added == 0 ) {
+			return;
+		}
+
+		const uint64_t aligned = (static_cast<uint64_t>(symbols) << (64 - n)) & (~0ULL << (64 - n_added));
+		const size_t index = count / word_bits;
+		const size_t offset = count % word_bits;
+		const uint64_t shifted = aligned >> offset;
+		data[index] |= static_cast<uint32_t>(shifted >> 32);
+		if( (offset + n_added) > word_bits ) {
+			data[index + 1] |= static_cast<uint32_t>(shifted);
+		}
+		count += n_added;
+	}
+
 	uint_fast8_t operator[](const size_t index) const {
-		return (index < size()) ? data[index] : 0;
+		return (index < size()) ? ((data[index / word_bits] >> (word_bits - 1 - (index % word_bits))) & 1) : 0;
+	}
+
+	/* Packed bits, first-received in the most significant bit. Bits past
+	 * size() are zero.
+	 */
+	uint32_t word(const size_t index) const {
+		return (index < data.size()) ? data[index] : 0;
 	}
 
 	size_t size() const {
@@ -54,15 +86,19 @@ public:
 	}
 
 	size_t capacity() const {
-		return data.size();
+		return data.size() * word_bits;
 	}
 
 	void clear() {
+		std::fill(&data[0], &data[(count + word_bits - 1) / word_bits], 0);
 		count = 0;
 	}
 
+	static constexpr size_t word_bits = 32;
+
 private:
-	std::bitset<1408> data { };
+	/* Bits are packed first-received in the most significant bit. */
+	std::array<uint32_t, 1408 / word_bits> data { };
 	Timestamp timestamp_ { };
 	size_t count { 0 };
 };
@@ -31,6 +31,11 @@ public:
 		history = (history << 1) | (bit & 1);
 	}
 
+	/* Add the low count (1 to 32) bits of bits, oldest bit most significant. */
+	void add(const uint32_t bits, const size_t count) {
+		history = (history << count) | (bits & (0xffffffffU >> (32 - count)));
+	}
+
 	uint64_t value() const {
 		return history;
 	}
@@ -64,6 +69,18 @@ public:
 		return (count <= maximum_hanning_distance_);
 	}
 
+	constexpr uint64_t code() const {
+		return code_;
+	}
+
+	constexpr uint64_t mask() const {
+		return mask_;
+	}
+
+	constexpr size_t maximum_hanning_distance() const {
+		return maximum_hanning_distance_;
+	}
+
 private:
 	uint64_t code_;
 	uint64_t mask_;
@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <limits>
 #include <array>
+#include <algorithm>
 
 /* Inspired by
  * http://www.barrgroup.com/Embedded-Systems/How-To/CRC-Calculation-C-Code
@@ -153,16 +154,202 @@ private:
 	}
 };
 
+/* CRC with lookup tables generated at compile time, with the same interface
+ * as CRC. The polynomial is a template parameter so the tables can be
+ * constexpr. Slices = 4 processes four bytes per step with four tables
+ * (slice-by-4), trading 3 KiB more table for fewer dependent lookups.
+ *
+ * When RevIn is set, the remainder is kept reflected so each byte is one
+ * shift and lookup; the result is reflected back before applying RevOut.
+ */
+template<size_t Width, uint32_t TruncatedPolynomial, bool RevIn = false, bool RevOut = false, size_t Slices = 1>
+class TableCRC {
+public:
+	using value_type = uint32_t;
+
+	static_assert((Width >= 8) && (Width <= 32), "Width must be 8 to 32 bits");
+	static_assert((Slices == 1) || (Slices == 4), "Slices must be 1 or 4");
+
+	constexpr TableCRC(
+		const value_type initial_remainder = 0,
+		const value_type final_xor_value = 0
+	) : initial_remainder { initial_remainder },
+		final_xor_value { final_xor_value },
+		remainder { to_register(initial_remainder) }
+	{
+	}
+
+	value_type get_initial_remainder() const {
+		return initial_remainder;
+	}
+
+	void reset(value_type new_initial_remainder) {
+		remainder = to_register(new_initial_remainder);
+	}
+
+	void reset() {
+		remainder = to_register(initial_remainder);
+	}
+
+	void process_bit(bool bit) {
+		if( RevIn ) {
+			remainder ^= (bit ? 1U : 0U);
+			remainder = (remainder & 1) ? ((remainder >> 1) ^ polynomial) : (remainder >> 1);
+		} else {
+			remainder ^= (bit ? top_bit() : 0U);
+			remainder = ((remainder & top_bit()) ? ((remainder << 1) ^ polynomial) : (remainder << 1)) & mask();
+		}
+	}
+
+	void process_bits(value_type bits, size_t bit_count) {
+		for(size_t i=0; i<bit_count; i++) {
+			process_bit((bits >> (RevIn ? i : (bit_count - 1 - i))) & 1);
+		}
+	}
+
+	void process_byte(const uint8_t byte) {
+		if( RevIn ) {
+			remainder = (remainder >> 8) ^ table[0][(remainder ^ byte) & 0xff];
+		} else {
+			remainder = ((remainder << 8) ^ table[0][((remainder >> (width() - 8)) ^ byte) & 0xff]) & mask();
+		}
+	}
+
+	void process_bytes(const void* const data, const size_t length) {
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+		const uint8_t* const end = p + length;
+		if( Slices == 4 ) {
+			for(; (end - p) >= 4; p+=4) {
+				process_slice(p);
+			}
+		}
+		while(p < end) {
+			process_byte(*(p++));
+		}
+	}
+
+	template<size_t N>
+	void process_bytes(const std::array<uint8_t, N>& data) {
+		process_bytes(data.data(), data.size());
+	}
+
+	value_type checksum() const {
+		const auto value = RevIn ? reflect(remainder) : remainder;
+		return ((RevOut ? reflect(value) : value) ^ final_xor_value) & mask();
+	}
+
+private:
+	using table_type = std::array<std::array<value_type, 256>, Slices>;
+
+	const value_type initial_remainder;
+	const value_type final_xor_value;
+	value_type remainder;
+
+	static constexpr size_t width() {
+		return Width;
+	}
+
+	static constexpr value_type top_bit() {
+		return 1U << (width() - 1);
+	}
+
+	static constexpr value_type mask() {
+		return (width() == 32) ? 0xffffffffU : ((1U << width()) - 1);
+	}
+
+	static constexpr value_type reflect(value_type x) {
+		value_type reflection = 0;
+		for(size_t i=0; i<width(); ++i) {
+			reflection <<= 1;
+			reflection |= (x & 1);
+			x >>= 1;
+		}
+		return reflection;
+	}
+
+	static constexpr value_type to_register(const value_type value) {
+		return RevIn ? reflect(value & mask()) : (value & mask());
+	}
+
+	static constexpr value_type polynomial = RevIn ? reflect(TruncatedPolynomial & mask()) : (TruncatedPolynomial & mask());
+
+	/* table[k][i]: remainder contribution of byte i followed by k zero bytes. */
+	static constexpr table_type make_table() {
+		table_type result { };
+		for(size_t i=0; i<256; i++) {
+			value_type r = RevIn ? i : (static_cast<value_type>(i) << (width() - 8));
+			for(size_t bit=0; bit<8; bit++) {
+				if( RevIn ) {
+					r = (r & 1) ? ((r >> 1) ^ polynomial) : (r >> 1);
+				} else {
+					r = ((r & top_bit()) ? ((r << 1) ^ polynomial) : (r << 1)) & mask();
+				}
+			}
+			result[0][i] = r;
+		}
+		for(size_t k=1; k<Slices; k++) {
+			for(size_t i=0; i<256; i++) {
+				const auto r = result[k - 1][i];
+				if( RevIn ) {
+					result[k][i] = (r >> 8) ^ result[0][r & 0xff];
+				} else {
+					result[k][i] = ((r << 8) ^ result[0][(r >> (width() - 8)) & 0xff]) & mask();
+				}
+			}
+		}
+		return result;
+	}
+
+	static constexpr table_type table = make_table();
+
+	void process_slice(const uint8_t* const p) {
+		if( RevIn ) {
+			const value_type x = remainder ^ (
+				(static_cast<value_type>(p[0]) <<  0) | (static_cast<value_type>(p[1]) <<  8) |
+				(static_cast<value_type>(p[2]) << 16) | (static_cast<value_type>(p[3]) << 24)
+			);
+			remainder = table[3][(x >>  0) & 0xff] ^ table[2][(x >>  8) & 0xff]
+			          ^ table[1][(x >> 16) & 0xff] ^ table[0][(x >> 24) & 0xff];
+		} else {
+			const value_type x = (remainder << (32 - width())) ^ (
+				(static_cast<value_type>(p[0]) << 24) | (static_cast<value_type>(p[1]) << 16) |
+				(static_cast<value_type>(p[2]) <<  8) | (static_cast<value_type>(p[3]) <<  0)
+			);
+			remainder = table[3][(x >> 24) & 0xff] ^ table[2][(x >> 16) & 0xff]
+			          ^ table[1][(x >>  8) & 0xff] ^ table[0][(x >>  0) & 0xff];
+		}
+	}
+};
+
+/* Sums are reduced modulo 65521 only every nmax bytes, the most that can be
+ * summed without overflowing 32 bits (see zlib). The count carries across
+ * feed() calls, so single bytes cost no more than blocks.
+ */
 class Adler32 {
 public:
 	void feed(const uint8_t v) {
-		feed_one(v);
+		a += v;
+		b += a;
+		if( ++pending == nmax ) {
+			reduce();
+		}
 	}
 
 	void feed(const void* const data, const size_t n) {
-		const uint8_t* const p = reinterpret_cast<const uint8_t*>(data);
-		for(size_t i=0; i<n; i++) {
-			feed_one(p[i]);
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+		size_t remaining = n;
+		while(remaining > 0) {
+			const size_t block = std::min(remaining, nmax - pending);
+			for(size_t i=0; i<block; i++) {
+				a += p[i];
+				b += a;
+			}
+			p += block;
+			remaining -= block;
+			pending += block;
+			if( pending == nmax ) {
+				reduce();
+			}
 		}
 	}
 
@@ -172,23 +359,28 @@ public:
 	}
 
 	std::array<uint8_t, 4> bytes() const {
+		const uint32_t a_mod = a % mod;
+		const uint32_t b_mod = b % mod;
 		return {
-			static_cast<uint8_t>((b >> 8) & 0xff),
-			static_cast<uint8_t>((b >> 0) & 0xff),
-			static_cast<uint8_t>((a >> 8) & 0xff),
-			static_cast<uint8_t>((a >> 0) & 0xff)
+			static_cast<uint8_t>((b_mod >> 8) & 0xff),
+			static_cast<uint8_t>((b_mod >> 0) & 0xff),
+			static_cast<uint8_t>((a_mod >> 8) & 0xff),
+			static_cast<uint8_t>((a_mod >> 0) & 0xff)
 		};
 	}
 
 private:
 	static constexpr uint32_t mod = 65521;
+	static constexpr size_t nmax = 5552;
 
 	uint32_t a { 1 };
 	uint32_t b { 0 };
+	size_t pending { 0 };
 
-	void feed_one(const uint8_t c) {
-		a = (a + c) % mod;
-		b = (b + a) % mod;
+	void reduce() {
+		a %= mod;
+		b %= mod;
+		pending = 0;
 	}
 };
 
@@ -216,58 +216,6 @@ constexpr fir_taps_complex<64> taps_6k0_dsb_channel {
 	} },
 };
 
-// USB AM 2K80J3E emission type ///////////////////////////////////////////
-
-// IFIR prototype filter: fs=12000, pass=3000, stop=3300, decim=1, fout=12000
-constexpr fir_taps_complex<64> taps_2k8_usb_channel {
-	.pass_frequency_normalized = 3000.0f / 12000.0f,
-	.stop_frequency_normalized = 3300.0f / 12000.0f,
-	.taps = { {
-		{   -146,      0 }, {    -41,    -45 }, {     -1,     10 }, {    -95,     69 },
-		{   -194,    -41 }, {    -91,   -158 }, {     14,    -43 }, {   -150,     67 },
-		{   -299,   -133 }, {   -100,   -307 }, {     50,    -86 }, {   -254,     54 },
-		{   -453,   -329 }, {    -62,   -587 }, {    170,   -189 }, {   -334,      0 },
-		{   -580,   -645 }, {    104,   -986 }, {    418,   -304 }, {   -412,    -88 },
-		{   -680,  -1178 }, {    527,  -1623 }, {    970,   -432 }, {   -441,   -196 },
-		{   -698,  -2149 }, {   1617,  -2800 }, {   2384,   -507 }, {   -429,   -311 },
-		{   -545,  -5181 }, {   6925,  -7691 }, {  14340,      0 }, {  10601,  11773 },
-		{  -1499,  14261 }, {  -8373,   6083 }, {  -5095,  -1083 }, {   -265,   -459 },
-		{   -753,   2318 }, {  -2954,   1315 }, {  -2064,   -919 }, {   -149,   -459 },
-		{   -531,    920 }, {  -1669,    355 }, {  -1100,   -800 }, {    -44,   -419 },
-		{   -346,    384 }, {   -992,      0 }, {   -580,   -645 }, {     35,   -332 },
-		{   -205,    149 }, {   -577,   -123 }, {   -280,   -485 }, {     80,   -247 },
-		{    -91,     40 }, {   -294,   -131 }, {   -101,   -312 }, {     82,   -142 },
-		{    -44,      9 }, {   -147,   -107 }, {    -21,   -197 }, {     79,    -88 },
-		{     10,      0 }, {    -41,    -45 }, {     15,   -145 }, {      0,      0 },
-	} },
-};
-
-// LSB AM 2K80J3E emission type ///////////////////////////////////////////
-
-// IFIR prototype filter: fs=12000, pass=3000, stop=3300, decim=1, fout=12000
-constexpr fir_taps_complex<64> taps_2k8_lsb_channel {
-	.pass_frequency_normalized = 3000.0f / 12000.0f,
-	.stop_frequency_normalized = 3300.0f / 12000.0f,
-	.taps = { {
-		{   -146,      0 }, {    -41,     45 }, {     -1,    -10 }, {    -95,    -69 },
-		{   -194,     41 }, {    -91,    158 }, {     14,     43 }, {   -150,    -67 },
-		{   -299,    133 }, {   -100,    307 }, {     50,     86 }, {   -254,    -54 },
-		{   -453,    329 }, {    -62,    587 }, {    170,    189 }, {   -334,      0 },
-		{   -580,    645 }, {    104,    986 }, {    418,    304 }, {   -412,     88 },
-		{   -680,   1178 }, {    527,   1623 }, {    970,    432 }, {   -441,    196 },
-		{   -698,   2149 }, {   1617,   2800 }, {   2384,    507 }, {   -429,    311 },
-		{   -545,   5181 }, {   6925,   7691 }, {  14340,      0 }, {  10601, -11773 },
-		{  -1499, -14261 }, {  -8373,  -6083 }, {  -5095,   1083 }, {   -265,    459 },
-		{   -753,  -2318 }, {  -2954,  -1315 }, {  -2064,    919 }, {   -149,    459 },
-		{   -531,   -920 }, {  -1669,   -355 }, {  -1100,    800 }, {    -44,    419 },
-		{   -346,   -384 }, {   -992,      0 }, {   -580,    645 }, {     35,    332 },
-		{   -205,   -149 }, {   -577,    123 }, {   -280,    485 }, {     80,    247 },
-		{    -91,    -40 }, {   -294,    131 }, {   -101,    312 }, {     82,    142 },
-		{    -44,     -9 }, {   -147,    107 }, {    -21,    197 }, {     79,     88 },
-		{     10,      0 }, {    -41,     45 }, {     15,    145 }, {      0,      0 },
-	} },
-};
-
 // WFM 200KF8E emission type //////////////////////////////////////////////
 
 // IFIR image-reject filter: fs=3072000, pass=100000, stop=484000, decim=4, fout=768000
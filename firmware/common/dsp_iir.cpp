@@ -27,6 +27,11 @@ void IIRBiquadFilter::configure(const iir_biquad_config_t& new_config) {
 	config = new_config;
 }
 
+void IIRBiquadFilter::reset() {
+	x = { { 0.0f, 0.0f, 0.0f } };
+	y = { { 0.0f, 0.0f, 0.0f } };
+}
+
 void IIRBiquadFilter::execute(const buffer_f32_t& buffer_in, const buffer_f32_t& buffer_out) {
 	const auto a_ = config.a;
 	const auto b_ = config.b;
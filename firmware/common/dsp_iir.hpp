@@ -57,6 +57,7 @@ public:
 	}
 
 	void configure(const iir_biquad_config_t& new_config);
+	void reset();
 
 	void execute(const buffer_f32_t& buffer_in, const buffer_f32_t& buffer_out);
 	void execute_in_place(const buffer_f32_t& buffer);
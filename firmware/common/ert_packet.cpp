@@ -26,7 +26,7 @@
 namespace ert {
 
 size_t Packet::length() const {
-	return decoder_.symbols_count();
+	return packet_.symbols_count();
 }
 
 bool Packet::is_valid() const {
@@ -74,10 +74,14 @@ CommodityType Packet::commodity_type() const {
 }
 
 FormattedSymbols Packet::symbols_formatted() const {
-	return format_symbols(decoder_);
+	return format_symbols(packet_);
 }
 
 bool Packet::crc_ok() const {
+	if( validated_ ) {
+		return true;
+	}
+
 	switch(type()) {
 	case Type::SCM:	return crc_ok_scm();
 	case Type::IDM:	return crc_ok_idm();
@@ -86,7 +90,7 @@ bool Packet::crc_ok() const {
 }
 
 bool Packet::crc_ok_scm() const {
-	CRC<16> ert_bch { 0x6f63 };
+	TableCRC<16, 0x6f63> ert_bch { };
 	size_t start_bit = 5;
 	ert_bch.process_byte(reader_.read(0, start_bit));
 	for(size_t i=start_bit; i<length(); i+=8) {
@@ -96,7 +100,7 @@ bool Packet::crc_ok_scm() const {
 }
 
 bool Packet::crc_ok_idm() const {
-	CRC<16> ert_crc_ccitt { 0x1021, 0xffff, 0x1d0f };
+	TableCRC<16, 0x1021> ert_crc_ccitt { 0xffff, 0x1d0f };
 	for(size_t i=0; i<length(); i+=8) {
 		ert_crc_ccitt.process_byte(reader_.read(i, 8));
 	}
@@ -26,7 +26,6 @@
 #include <cstddef>
 
 #include "field_reader.hpp"
-#include "baseband_packet.hpp"
 #include "manchester.hpp"
 
 namespace ert {
@@ -49,11 +48,12 @@ public:
 
 	Packet(
 		const Type type,
-		const baseband::Packet& packet
+		const ManchesterPacket& packet,
+		const bool validated = false
 	) : packet_ { packet },
-		decoder_ { packet_ },
-		reader_ { decoder_ },
-		type_ { type }
+		reader_ { packet_ },
+		type_ { type },
+		validated_ { validated }
 	{
 	}
 
@@ -73,12 +73,13 @@ public:
 	bool crc_ok() const;
 
 private:
-	using Reader = FieldReader<ManchesterDecoder, BitRemapNone>;
+	using Reader = FieldReader<ManchesterPacket, BitRemapNone>;
 
-	const baseband::Packet packet_;
-	const ManchesterDecoder decoder_;
+	const ManchesterPacket packet_;
 	const Reader reader_;
 	const Type type_;
+	/* CRC already checked by the baseband. */
+	const bool validated_;
 
 	bool crc_ok_idm() const;
 	bool crc_ok_scm() const;
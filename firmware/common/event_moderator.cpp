@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "event_moderator.hpp"
+
+#include "lpc43xx_cpp.hpp"
+using namespace lpc43xx;
+
+/* At most one interrupt per 2ms, or per 8 deferred messages. */
+EventModerator m4_event_moderator { MS2ST(2), 8 };
+
+void EventModerator::post() {
+	chSysLock();
+	requests_count = requests_count + 1;
+	pending = pending + 1;
+	if( pending >= max_pending ) {
+		signal();
+	} else if( !chVTIsArmedI(&timer) ) {
+		chVTSetI(&timer, interval, timer_callback, this);
+	}
+	chSysUnlock();
+}
+
+void EventModerator::post_immediate() {
+	/* An armed timer finding nothing pending does nothing. */
+	chSysLock();
+	requests_count = requests_count + 1;
+	signal();
+	chSysUnlock();
+}
+
+void EventModerator::signal() {
+	pending = 0;
+	signals_count = signals_count + 1;
+	creg::m4txevent::assert_event();
+}
+
+void EventModerator::timer_callback(void* const arg) {
+	auto moderator = static_cast<EventModerator*>(arg);
+	if( moderator->pending ) {
+		moderator->signal();
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __EVENT_MODERATOR_H__
+#define __EVENT_MODERATOR_H__
+
+#include "ch.h"
+
+#include <cstdint>
+#include <cstddef>
+
+/* Coalesces M4-to-M0 event signals. Deferred posts are signalled together
+ * once max_pending have accumulated or the interval has elapsed since the
+ * first of them, whichever is sooner.
+ */
+class EventModerator {
+public:
+	constexpr EventModerator(
+		const systime_t interval,
+		const size_t max_pending
+	) : interval { interval },
+		max_pending { max_pending }
+	{
+	}
+
+	/* Signal as part of the next coalesced event. */
+	void post();
+
+	/* Signal now, taking any deferred posts along. Needs the kernel
+	 * running, not for use after chSysDisable().
+	 */
+	void post_immediate();
+
+	/* Running totals, for measuring the interrupt rate. */
+	uint32_t requests() const {
+		return requests_count;
+	}
+
+	uint32_t signals() const {
+		return signals_count;
+	}
+
+private:
+	VirtualTimer timer { };
+	const systime_t interval;
+	const size_t max_pending;
+	volatile size_t pending { 0 };
+	volatile uint32_t requests_count { 0 };
+	volatile uint32_t signals_count { 0 };
+
+	void signal();
+
+	static void timer_callback(void* const arg);
+};
+
+extern EventModerator m4_event_moderator;
+
+#endif/*__EVENT_MODERATOR_H__*/
@@ -24,19 +24,42 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
 struct BitRemapNone {
 	constexpr size_t operator()(const size_t& bit_index) const {
 		return bit_index;
 	}
+
+	/* Same remap applied to a packed 32-bit word. */
+	static constexpr uint32_t word(const uint32_t w) {
+		return w;
+	}
 };
 
 struct BitRemapByteReverse {
 	constexpr size_t operator()(const size_t bit_index) const {
 		return bit_index ^ 7;
 	}
+
+	static constexpr uint32_t word(uint32_t w) {
+		w = ((w >> 1) & 0x55555555) | ((w & 0x55555555) << 1);
+		w = ((w >> 2) & 0x33333333) | ((w & 0x33333333) << 2);
+		w = ((w >> 4) & 0x0f0f0f0f) | ((w & 0x0f0f0f0f) << 4);
+		return w;
+	}
 };
 
+/* Sources with a word(index) accessor returning bits packed MSB-first in
+ * 32-bit words, zero past the end, are read a word pair at a time.
+ */
+template<typename T, typename = void>
+struct has_packed_words : std::false_type { };
+
+template<typename T>
+struct has_packed_words<T, std::void_t<decltype(std::declval<const T&>().word(size_t { }))>> : std::true_type { };
+
 template<typename T, typename BitRemap>
 class FieldReader {
 public:
@@ -50,16 +73,33 @@ public:
 	/* The BitRemap functor determines which bits are read from the source
 	 * packet. */
 	uint32_t read(const size_t start_bit, const size_t length) const {
-		uint32_t value = 0;
-		for(size_t i=start_bit; i<(start_bit + length); i++) {
-			value = (value << 1) | data[bit_remap(i)];
+		if constexpr (has_packed_words<T>::value) {
+			return read_words(start_bit, length);
+		} else {
+			uint32_t value = 0;
+			for(size_t i=start_bit; i<(start_bit + length); i++) {
+				value = (value << 1) | data[bit_remap(i)];
+			}
+			return value;
 		}
-		return value;
 	}
 
 private:
 	const T& data;
 	const BitRemap bit_remap { };
+
+	uint32_t read_words(const size_t start_bit, const size_t length) const {
+		if( length == 0 ) {
+			return 0;
+		}
+
+		const size_t index = start_bit / 32;
+		const size_t offset = start_bit % 32;
+		const uint64_t window =
+			(static_cast<uint64_t>(BitRemap::word(data.word(index + 0))) << 32) |
+			 static_cast<uint64_t>(BitRemap::word(data.word(index + 1)));
+		return (window << offset) >> (64 - length);
+	}
 };
 
 #endif/*__FIELD_READER_H__*/
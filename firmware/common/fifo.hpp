@@ -106,11 +106,45 @@ public:
 		return len;
 	}
 
+	/* In-place production: returns the next free slot, or nullptr if
+	 * full. The slot is published by commit(). Single producer.
+	 */
+	T* reserve() {
+		if( is_full() ) {
+			return nullptr;
+		}
+
+		return &_data[_in & mask()];
+	}
+
+	void commit() {
+		smp_wmb();
+		_in += 1;
+	}
+
+	/* In-place consumption: returns the oldest slot, or nullptr if empty.
+	 * The slot stays valid until release(). Single consumer.
+	 */
+	T* peek() {
+		if( is_empty() ) {
+			return nullptr;
+		}
+
+		smp_rmb();
+		return &_data[_out & mask()];
+	}
+
+	void release() {
+		smp_mb();
+		_out += 1;
+	}
+
 	bool out(T& val) {
 		if( is_empty() ) {
 			return false;
 		}
 
+		smp_rmb();
 		val = _data[_out & mask()];
 		smp_wmb();
 		_out += 1;
@@ -172,10 +206,19 @@ private:
 		return 2;
 	}
 
+	/* Cortex-M has a single barrier instruction for all three cases. */
 	void smp_wmb() {
 		__DMB();
 	}
 
+	void smp_rmb() {
+		__DMB();
+	}
+
+	void smp_mb() {
+		__DMB();
+	}
+
 	size_t peek_n() {
 		size_t l = _data[_out & mask()];
 		if( recsize() > 1 ) {
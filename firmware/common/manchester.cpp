@@ -23,25 +23,10 @@
 
 #include "string_format.hpp"
 
-DecodedSymbol ManchesterDecoder::operator[](const size_t index) const {
-	const size_t encoded_index = index * 2;
-	if( (encoded_index + 1) < packet.size() ) {
-		const auto value = packet[encoded_index + sense];
-		const auto error = packet[encoded_index + 0] == packet[encoded_index + 1];
-		return { value, error };
-	} else {
-		return { 0, 1 };
-	}
-}
-
-size_t ManchesterDecoder::symbols_count() const {
-	return packet.size() / 2;
-}
-
 FormattedSymbols format_symbols(
-	const ManchesterDecoder& decoder
+	const ManchesterPacket& packet
 ) {
-	const size_t payload_length_decoded = decoder.symbols_count();
+	const size_t payload_length_decoded = packet.symbols_count();
 	const size_t payload_length_hex_characters = (payload_length_decoded + 3) / 4;
 	const size_t payload_length_symbols_rounded = payload_length_hex_characters * 4;
 
@@ -53,7 +38,7 @@ FormattedSymbols format_symbols(
 	uint_fast8_t data = 0;
 	uint_fast8_t error = 0;
 	for(size_t i=0; i<payload_length_symbols_rounded; i++) {
-		const auto symbol = decoder[i];
+		const auto symbol = packet[i];
 
 		data <<= 1;
 		data |= symbol.value;
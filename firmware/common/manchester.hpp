@@ -24,7 +24,7 @@
 
 #include <cstdint>
 #include <cstddef>
-#include <bitset>
+#include <array>
 #include <string>
 
 #include "baseband_packet.hpp"
@@ -34,23 +34,122 @@ struct DecodedSymbol {
 	uint_fast8_t error;
 };
 
-class ManchesterDecoder {
+/* Manchester-decoded packet: symbol values packed MSB-first, followed by a
+ * bitmap of symbols whose two halves were equal. Only the first size_bytes()
+ * bytes of the object are meaningful, so it can be queued truncated.
+ */
+class ManchesterPacket {
 public:
-	constexpr ManchesterDecoder(
+	static constexpr size_t symbols_capacity = 1408 / 2;
+
+	constexpr ManchesterPacket(
+	) {
+	}
+
+	ManchesterPacket(
 		const baseband::Packet& packet,
 		const size_t sense = 0
-	) : packet { packet },
-		sense { sense }
+	) : timestamp_ { packet.timestamp() },
+		symbols_count_ { static_cast<uint16_t>(packet.size() / 2) }
 	{
+		const size_t length = bytes_length();
+		const size_t words = (symbols_count_ + 15) / 16;
+		for(size_t i=0; i<words; i++) {
+			const uint32_t raw = packet.word(i);
+			const uint32_t values = compress((sense ? raw : (raw >> 1)) & 0x55555555);
+			const uint32_t errors = compress(~(raw ^ (raw >> 1)) & 0x55555555);
+			const size_t index = i * 2;
+			bytes_[index + 0] = values >> 8;
+			bytes_[length + index + 0] = errors >> 8;
+			if( (index + 1) < length ) {
+				bytes_[index + 1] = values;
+				bytes_[length + index + 1] = errors;
+			}
+		}
+
+		/* Clear padding past the last symbol, which may hold a trailing
+		 * half-symbol and otherwise decodes as errors.
+		 */
+		if( length > 0 ) {
+			const size_t tail_bits = (length * 8) - symbols_count_;
+			bytes_[length - 1] &= (0xff << tail_bits);
+			bytes_[length * 2 - 1] &= (0xff << tail_bits);
+		}
+
+		for(size_t i=0; i<length; i++) {
+			errors_count_ += __builtin_popcount(bytes_[length + i]);
+		}
+	}
+
+	Timestamp timestamp() const {
+		return timestamp_;
+	}
+
+	size_t symbols_count() const {
+		return symbols_count_;
+	}
+
+	size_t errors_count() const {
+		return errors_count_;
+	}
+
+	/* Symbols before the first decoding error; symbols_count() if none. */
+	size_t symbols_before_error() const {
+		const size_t length = bytes_length();
+		for(size_t i=0; i<length; i++) {
+			const uint32_t errors = bytes_[length + i];
+			if( errors ) {
+				return i * 8 + (__builtin_clz(errors) - 24);
+			}
+		}
+		return symbols_count();
 	}
 
-	DecodedSymbol operator[](const size_t index) const;
+	DecodedSymbol operator[](const size_t index) const {
+		if( index < symbols_count() ) {
+			const size_t byte_index = index / 8;
+			const size_t bit = 7 - (index % 8);
+			return {
+				static_cast<uint_fast8_t>((bytes_[byte_index] >> bit) & 1),
+				static_cast<uint_fast8_t>((bytes_[bytes_length() + byte_index] >> bit) & 1)
+			};
+		} else {
+			return { 0, 1 };
+		}
+	}
 
-	size_t symbols_count() const;
+	/* Symbol values packed MSB-first, zero past the last symbol. */
+	uint32_t word(const size_t index) const {
+		uint32_t result = 0;
+		for(size_t i=index*4; i<(index*4 + 4); i++) {
+			result = (result << 8) | ((i < bytes_length()) ? bytes_[i] : 0);
+		}
+		return result;
+	}
+
+	size_t size_bytes() const {
+		const auto base = reinterpret_cast<const uint8_t*>(this);
+		return (bytes_.data() - base) + bytes_length() * 2;
+	}
 
 private:
-	const baseband::Packet& packet;
-	const size_t sense;
+	Timestamp timestamp_ { };
+	uint16_t symbols_count_ { 0 };
+	uint16_t errors_count_ { 0 };
+	std::array<uint8_t, symbols_capacity / 8 * 2> bytes_ { };
+
+	size_t bytes_length() const {
+		return (symbols_count_ + 7) / 8;
+	}
+
+	/* Gather the even bits of a word into the low half, order preserved. */
+	static constexpr uint32_t compress(uint32_t x) {
+		x = (x | (x >> 1)) & 0x33333333;
+		x = (x | (x >> 2)) & 0x0f0f0f0f;
+		x = (x | (x >> 4)) & 0x00ff00ff;
+		x = (x | (x >> 8)) & 0x0000ffff;
+		return x;
+	}
 };
 
 template<typename T>
@@ -64,7 +163,7 @@ struct FormattedSymbols {
 };
 
 FormattedSymbols format_symbols(
-	const ManchesterDecoder& decoder
+	const ManchesterPacket& packet
 );
 
 #endif/*__MANCHESTER_H__*/
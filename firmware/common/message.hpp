@@ -30,8 +30,10 @@
 #include <algorithm>
 
 #include "baseband_packet.hpp"
+#include "manchester.hpp"
 #include "ert_packet.hpp"
 #include "tpms_packet.hpp"
+#include "rds_group.hpp"
 #include "dsp_fir_taps.hpp"
 #include "dsp_iir.hpp"
 #include "fifo.hpp"
@@ -64,6 +66,9 @@ public:
 		DisplaySleep = 16,
 		CaptureConfig = 17,
 		CaptureThreadDone = 18,
+		RDSGroup = 19,
+		PacketStatistics = 20,
+		CaptureConfigure = 21,
 		MAX
 	};
 
@@ -100,6 +105,10 @@ struct BasebandStatistics {
 	uint32_t main_ticks { 0 };
 	uint32_t rssi_ticks { 0 };
 	uint32_t baseband_ticks { 0 };
+	uint32_t events_requested { 0 };
+	uint32_t events_signalled { 0 };
+	uint32_t channel_blocks { 0 };
+	uint32_t channel_idle_blocks { 0 };
 	bool saturation { false };
 };
 
@@ -233,29 +242,80 @@ public:
 
 class AISPacketMessage : public Message {
 public:
+	static constexpr ID type_id = ID::AISPacket;
+
 	constexpr AISPacketMessage(
-		const baseband::Packet& packet
-	) : Message { ID::AISPacket },
-		packet { packet }
+		const baseband::Packet& packet,
+		const bool validated = false,
+		const uint32_t repeat_count = 0
+	) : Message { type_id },
+		packet { packet },
+		validated { validated },
+		repeat_count { repeat_count }
 	{
 	}
 
 	baseband::Packet packet;
+	bool validated;
+	/* Duplicates suppressed by the baseband since the previous packet. */
+	uint32_t repeat_count;
 };
 
 class TPMSPacketMessage : public Message {
 public:
-	constexpr TPMSPacketMessage(
+	static constexpr ID type_id = ID::TPMSPacket;
+
+	TPMSPacketMessage(
 		const tpms::SignalType signal_type,
-		const baseband::Packet& packet
-	) : Message { ID::TPMSPacket },
+		const ManchesterPacket& packet,
+		const uint32_t repeat_count = 0
+	) : Message { type_id },
 		signal_type { signal_type },
+		repeat_count { repeat_count },
 		packet { packet }
 	{
 	}
 
+	/* Bytes up to the end of the decoded payload. */
+	size_t size() const {
+		return (reinterpret_cast<const uint8_t*>(&packet) - reinterpret_cast<const uint8_t*>(this)) + packet.size_bytes();
+	}
+
 	tpms::SignalType signal_type;
-	baseband::Packet packet;
+	/* Duplicates suppressed by the baseband since the previous packet. */
+	uint32_t repeat_count;
+	ManchesterPacket packet;
+};
+
+class RDSGroupMessage : public Message {
+public:
+	constexpr RDSGroupMessage(
+		const rds::Group& group
+	) : Message { ID::RDSGroup },
+		group(group)
+	{
+	}
+
+	rds::Group group;
+};
+
+/* Cumulative counts of packets completed by a packet processor. */
+struct PacketStatistics {
+	uint32_t accepted { 0 };
+	uint32_t rejected_length { 0 };
+	uint32_t rejected_crc { 0 };
+};
+
+class PacketStatisticsMessage : public Message {
+public:
+	constexpr PacketStatisticsMessage(
+		const PacketStatistics& statistics
+	) : Message { ID::PacketStatistics },
+		statistics { statistics }
+	{
+	}
+
+	PacketStatistics statistics;
 };
 
 class ShutdownMessage : public Message {
@@ -268,18 +328,32 @@ public:
 
 class ERTPacketMessage : public Message {
 public:
-	constexpr ERTPacketMessage(
+	static constexpr ID type_id = ID::ERTPacket;
+
+	ERTPacketMessage(
 		const ert::Packet::Type type,
-		const baseband::Packet& packet
-	) : Message { ID::ERTPacket },
+		const ManchesterPacket& packet,
+		const bool validated = false,
+		const uint32_t repeat_count = 0
+	) : Message { type_id },
 		type { type },
+		validated { validated },
+		repeat_count { repeat_count },
 		packet { packet }
 	{
 	}
 
+	/* Bytes up to the end of the decoded payload. */
+	size_t size() const {
+		return (reinterpret_cast<const uint8_t*>(&packet) - reinterpret_cast<const uint8_t*>(this)) + packet.size_bytes();
+	}
+
 	ert::Packet::Type type;
+	bool validated;
+	/* Duplicates suppressed by the baseband since the previous packet. */
+	uint32_t repeat_count;
 
-	baseband::Packet packet;
+	ManchesterPacket packet;
 };
 
 class UpdateSpectrumMessage : public Message {
@@ -351,7 +425,9 @@ class AMConfigureMessage : public Message {
 public:
 	enum class Modulation : int32_t {
 		DSB = 0,
-		SSB = 1,
+		USB = 1,
+		LSB = 2,
+		CW = 3,
 	};
 
 	constexpr AMConfigureMessage(
@@ -360,6 +436,9 @@ public:
 		const fir_taps_real<32> decim_2_filter,
 		const fir_taps_complex<64> channel_filter,
 		const Modulation modulation,
+		const int32_t passband_low_hz,
+		const int32_t passband_high_hz,
+		const int32_t bfo_hz,
 		const iir_biquad_config_t audio_hpf_config
 	) : Message { ID::AMConfigure },
 		decim_0_filter(decim_0_filter),
@@ -367,6 +446,9 @@ public:
 		decim_2_filter(decim_2_filter),
 		channel_filter(channel_filter),
 		modulation { modulation },
+		passband_low_hz { passband_low_hz },
+		passband_high_hz { passband_high_hz },
+		bfo_hz { bfo_hz },
 		audio_hpf_config(audio_hpf_config)
 	{
 	}
@@ -374,24 +456,34 @@ public:
 	const fir_taps_real<24> decim_0_filter;
 	const fir_taps_real<32> decim_1_filter;
 	const fir_taps_real<32> decim_2_filter;
+	/* DSB only. USB/LSB/CW channel filters are designed by the baseband
+	 * from the audio passband edges and BFO offset.
+	 */
 	const fir_taps_complex<64> channel_filter;
 	const Modulation modulation;
+	const int32_t passband_low_hz;
+	const int32_t passband_high_hz;
+	const int32_t bfo_hz;
 	const iir_biquad_config_t audio_hpf_config;
 };
 
 // TODO: Put this somewhere else, or at least the implementation part.
 class StreamBuffer {
 	uint8_t* data_;
+	size_t start_;
 	size_t used_;
 	size_t capacity_;
+	bool segment_end_;
 
 public:
 	constexpr StreamBuffer(
 		void* const data = nullptr,
 		const size_t capacity = 0
 	) : data_ { static_cast<uint8_t*>(data) },
+		start_ { 0 },
 		used_ { 0 },
-		capacity_ { capacity }
+		capacity_ { capacity },
+		segment_end_ { false }
 	{
 	}
 
@@ -407,23 +499,44 @@ public:
 	}
 
 	void* data() const {
-		return data_;
+		return &data_[start_];
 	}
 
 	size_t size() const {
-		return used_;
+		return used_ - start_;
 	}
 
 	void set_size(const size_t value) {
-		used_ = value;
+		used_ = start_ + value;
+	}
+
+	/* Drops data from the front, so the buffer's contents start later. */
+	void trim_front(const size_t count) {
+		start_ = std::min(start_ + count, used_);
+	}
+
+	/* Set on the last buffer of a segment, which may be partly filled or
+	 * empty. Buffers after it start a new segment.
+	 */
+	bool is_segment_end() const {
+		return segment_end_;
+	}
+
+	void set_segment_end() {
+		segment_end_ = true;
 	}
 
 	void empty() {
+		start_ = 0;
 		used_ = 0;
+		segment_end_ = false;
 	}
 };
 
 struct CaptureConfig {
+	static constexpr size_t buffer_count_max_log2 = 3;
+	static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
+
 	const size_t write_size;
 	const size_t buffer_count;
 	uint64_t baseband_bytes_received;
@@ -453,6 +566,48 @@ struct CaptureConfig {
 	}
 };
 
+class CaptureConfigureMessage : public Message {
+public:
+	enum class Format : uint32_t {
+		C16 = 0,
+		/* Requantized to 8 bits with triangular dither. */
+		C8 = 1,
+		/* C16, losslessly compressed (see baseband/iq_codec.hpp). */
+		RiceC16 = 2,
+	};
+
+	constexpr CaptureConfigureMessage(
+		const size_t decimation_factor,
+		const Format format,
+		const bool triggered = false,
+		const int32_t trigger_threshold_db = 0,
+		const uint32_t pre_trigger_ms = 0,
+		const uint32_t post_trigger_ms = 0
+	) : Message { ID::CaptureConfigure },
+		decimation_factor { decimation_factor },
+		format { format },
+		triggered { triggered },
+		trigger_threshold_db { trigger_threshold_db },
+		pre_trigger_ms { pre_trigger_ms },
+		post_trigger_ms { post_trigger_ms }
+	{
+	}
+
+	/* 4, 8, 16 or 32, from the baseband sampling rate. */
+	const size_t decimation_factor;
+	const Format format;
+
+	/* When triggered, only activity is captured: each time the channel peak
+	 * reaches the threshold (dBFS), a segment is recorded from pre_trigger_ms
+	 * before it until post_trigger_ms after the channel last exceeded it.
+	 * The pre-trigger history is kept in the stream buffers, which bound it.
+	 */
+	const bool triggered;
+	const int32_t trigger_threshold_db;
+	const uint32_t pre_trigger_ms;
+	const uint32_t post_trigger_ms;
+};
+
 class CaptureConfigMessage : public Message {
 public:
 	constexpr CaptureConfigMessage(
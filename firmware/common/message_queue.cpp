@@ -24,14 +24,53 @@
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+#include "hackrf_hal.hpp"
+using namespace hackrf::one;
+
+uint32_t MessageQueue::timestamp() {
+	/* Free-running at the base clock, started by the M0 HAL. The M4's DWT
+	 * cycle counter is not visible to the M0.
+	 */
+	return LPC_TIMER3->TC;
+}
+
+void MessageQueue::dispatched(const size_t offset) {
+	constexpr uint32_t ticks_per_us = base_m4_clk_f / 1000000;
+	const uint32_t stamp = header(offset + sizeof(uint32_t));
+	const uint32_t latency = (timestamp() - stamp) / ticks_per_us;
+	const auto id = reinterpret_cast<const Message*>(&data[offset + header_size])->id;
+
+	auto& c = counters(id);
+	c.dispatched++;
+	c.latency_total += latency;
+	c.latency_max = std::max(c.latency_max, latency);
+}
+
 #if defined(LPC43XX_M0)
-void MessageQueue::signal() {
+void MessageQueue::signal(const Message::ID) {
 	creg::m0apptxevent::assert_event();
 }
 #endif
 
 #if defined(LPC43XX_M4)
-void MessageQueue::signal() {
-	creg::m4txevent::assert_event();
+#include "event_moderator.hpp"
+
+void MessageQueue::signal(const Message::ID id) {
+	switch(id) {
+	case Message::ID::AISPacket:
+	case Message::ID::TPMSPacket:
+	case Message::ID::ERTPacket:
+		m4_event_moderator.post_immediate();
+		break;
+
+	case Message::ID::Shutdown:
+		/* Sent with the kernel disabled, so bypass the moderator. */
+		creg::m4txevent::assert_event();
+		break;
+
+	default:
+		m4_event_moderator.post();
+		break;
+	}
 }
 #endif
@@ -23,12 +23,42 @@
 #define __MESSAGE_QUEUE_H__
 
 #include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
 
 #include "message.hpp"
-#include "fifo.hpp"
+#include "utility.hpp"
 
 #include <ch.h>
 
+/* Counters are only written by the producer (under the write lock) or by
+ * the consumer, so either core may read them for diagnostics.
+ */
+struct MessageQueueStatistics {
+	struct Counters {
+		uint32_t pushed;
+		uint32_t dropped;
+		uint32_t bytes;
+		uint32_t dispatched;
+		/* Enqueue to dispatch, microseconds */
+		uint32_t latency_max;
+		uint32_t latency_total;
+	};
+
+	std::array<Counters, toUType(Message::ID::MAX)> by_id { };
+	/* Most bytes in use at once, including record overhead */
+	uint32_t high_water { 0 };
+};
+
+/* Records are a length word and an enqueue timestamp followed by the message, padded to a word
+ * boundary. A record never wraps: if it does not fit before the end of the
+ * buffer, a wrap marker is written and the record starts at the beginning.
+ * Producers build messages in place (reserve/commit) and consumers are
+ * handed pointers into the buffer, so messages are not copied through
+ * intermediate buffers.
+ */
 class MessageQueue {
 public:
 	MessageQueue() = delete;
@@ -38,7 +68,8 @@ public:
 	MessageQueue(
 		uint8_t* const data,
 		size_t k
-	) : fifo { data, k }
+	) : data { data },
+		size { 1U << k }
 	{
 		chMtxInit(&mutex_write);
 	}
@@ -48,7 +79,90 @@ public:
 		static_assert(sizeof(T) <= Message::MAX_SIZE, "Message::MAX_SIZE too small for message type");
 		static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
 
-		return push(&message, sizeof(message));
+		void* const p = reserve(message.id, sizeof(T));
+		if( p ) {
+			memcpy(p, &message, sizeof(T));
+			commit(sizeof(T));
+		}
+		return (p != nullptr);
+	}
+
+	/* Construct a message directly in the queue. T::type_id names the
+	 * message ID, for accounting drops.
+	 */
+	template<typename T, typename... Args>
+	bool emplace(Args&&... args) {
+		static_assert(sizeof(T) <= Message::MAX_SIZE, "Message::MAX_SIZE too small for message type");
+		static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
+
+		void* const p = reserve(T::type_id, sizeof(T));
+		if( p ) {
+			new (p) T(std::forward<Args>(args)...);
+			commit(sizeof(T));
+		}
+		return (p != nullptr);
+	}
+
+	/* As emplace(), for messages with a variable-length tail: only the
+	 * first size() bytes of the constructed message are kept.
+	 */
+	template<typename T, typename... Args>
+	bool emplace_partial(Args&&... args) {
+		static_assert(sizeof(T) <= Message::MAX_SIZE, "Message::MAX_SIZE too small for message type");
+		static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
+
+		void* const p = reserve(T::type_id, sizeof(T));
+		if( p ) {
+			const T* const message = new (p) T(std::forward<Args>(args)...);
+			commit(std::min(message->size(), sizeof(T)));
+		}
+		return (p != nullptr);
+	}
+
+	/* Returns space for a record of up to length bytes, or nullptr if the
+	 * queue is full (counted as a drop of id). Holds the write lock until
+	 * commit() or cancel().
+	 */
+	void* reserve(const Message::ID id, const size_t length) {
+		chMtxLock(&mutex_write);
+
+		const size_t offset = in & mask();
+		const size_t space_to_end = size - offset;
+		const size_t record = record_size(length);
+		reserved_skip = (record > space_to_end) ? space_to_end : 0;
+
+		if( (reserved_skip + record) > unused() ) {
+			counters(id).dropped++;
+			chMtxUnlock();
+			return nullptr;
+		}
+
+		if( reserved_skip ) {
+			header(offset) = wrap_marker;
+		}
+		return &data[((in + reserved_skip) & mask()) + header_size];
+	}
+
+	/* Publishes the reserved record, length no more than reserved. */
+	void commit(const size_t length) {
+		const size_t offset = (in + reserved_skip) & mask();
+		header(offset) = length;
+		header(offset + sizeof(uint32_t)) = timestamp();
+		const auto id = reinterpret_cast<const Message*>(&data[offset + header_size])->id;
+		__DMB();
+		in += reserved_skip + record_size(length);
+
+		auto& c = counters(id);
+		c.pushed++;
+		c.bytes += length;
+		statistics_.high_water = std::max<uint32_t>(statistics_.high_water, in - out);
+		chMtxUnlock();
+
+		signal(id);
+	}
+
+	void cancel() {
+		chMtxUnlock();
 	}
 
 	template<typename T>
@@ -61,58 +175,90 @@ public:
 		return result;
 	}
 
+	/* Handlers get a pointer into the queue, valid until they return. */
 	template<typename HandlerFn>
 	void handle(HandlerFn handler) {
-		std::array<uint8_t, Message::MAX_SIZE> message_buffer;
-		while(Message* const message = peek(message_buffer)) {
+		while(Message* const message = peek()) {
+			dispatched(out & mask());
 			handler(message);
 			skip();
 		}
 	}
 
 	bool is_empty() const {
-		return fifo.is_empty();
+		return in == out;
 	}
 
 	void reset() {
-		fifo.reset();
+		in = out = 0;
 	}
-	
+
+	size_t capacity() const {
+		return size;
+	}
+
+	const MessageQueueStatistics& statistics() const {
+		return statistics_;
+	}
+
 private:
-	FIFO<uint8_t> fifo;
+	static constexpr size_t header_size = 2 * sizeof(uint32_t);
+	static constexpr uint32_t wrap_marker = 0xffffffff;
+
+	uint8_t* const data;
+	const size_t size;
+	volatile size_t in { 0 };
+	volatile size_t out { 0 };
+	size_t reserved_skip { 0 };
 	Mutex mutex_write { };
+	MessageQueueStatistics statistics_ { };
 
-	Message* peek(std::array<uint8_t, Message::MAX_SIZE>& buf) {
-		Message* const p = reinterpret_cast<Message*>(buf.data());
-		return fifo.peek_r(buf.data(), buf.size()) ? p : nullptr;
+	size_t mask() const {
+		return size - 1;
 	}
 
-	bool skip() {
-		return fifo.skip();
+	size_t unused() const {
+		return size - (in - out);
 	}
 
-	Message* pop(std::array<uint8_t, Message::MAX_SIZE>& buf) {
-		Message* const p = reinterpret_cast<Message*>(buf.data());
-		return fifo.out_r(buf.data(), buf.size()) ? p : nullptr;
+	static constexpr size_t record_size(const size_t length) {
+		return header_size + ((length + 3) & ~3U);
 	}
 
-	size_t len() const {
-		return fifo.len();
+	volatile uint32_t& header(const size_t offset) {
+		return *reinterpret_cast<volatile uint32_t*>(&data[offset]);
 	}
 
-	bool push(const void* const buf, const size_t len) {
-		chMtxLock(&mutex_write);
-		const auto result = fifo.in_r(buf, len);
-		chMtxUnlock();
+	Message* peek() {
+		if( is_empty() ) {
+			return nullptr;
+		}
 
-		const bool success = (result == len);
-		if( success ) {
-			signal();
+		__DMB();
+		const size_t offset = out & mask();
+		if( header(offset) == wrap_marker ) {
+			out += size - offset;
+			return peek();
 		}
-		return success;
+		return reinterpret_cast<Message*>(&data[offset + header_size]);
 	}
 
-	void signal();
+	void skip() {
+		const size_t length = header(out & mask());
+		__DMB();
+		out += record_size(length);
+	}
+
+	MessageQueueStatistics::Counters& counters(const Message::ID id) {
+		return statistics_.by_id[std::min(toUType(id), toUType(Message::ID::MAX) - 1)];
+	}
+
+	void dispatched(const size_t offset);
+
+	/* Shared cycle counter, readable from both cores. */
+	static uint32_t timestamp();
+
+	void signal(const Message::ID id);
 };
 
 #endif/*__MESSAGE_QUEUE_H__*/
@@ -26,21 +26,28 @@
 #include <cstddef>
 
 #include "message_queue.hpp"
+#include "memory_map.hpp"
 
 /* NOTE: These structures must be located in the same location in both M4 and M0 binaries */
 struct SharedMemory {
 	static constexpr size_t application_queue_k = 11;
 	static constexpr size_t app_local_queue_k = 11;
+	static constexpr size_t baseband_queue_k = 11;
 
-	uint8_t application_queue_data[1 << application_queue_k] { 0 };
-	uint8_t app_local_queue_data[1 << app_local_queue_k] { 0 };
-	const Message* volatile baseband_message { nullptr };
+	alignas(4) uint8_t application_queue_data[1 << application_queue_k] { 0 };
+	alignas(4) uint8_t app_local_queue_data[1 << app_local_queue_k] { 0 };
+	alignas(4) uint8_t baseband_queue_data[1 << baseband_queue_k] { 0 };
 	MessageQueue application_queue { application_queue_data, application_queue_k };
 	MessageQueue app_local_queue { app_local_queue_data, app_local_queue_k };
+	/* Commands from M0 to M4, and how many of them the M4 has finished. */
+	MessageQueue baseband_queue { baseband_queue_data, baseband_queue_k };
+	volatile uint32_t baseband_completed { 0 };
 
 	char m4_panic_msg[32] { 0 };
 };
 
+static_assert(sizeof(SharedMemory) <= portapack::memory::map::shared_memory.size(), "SharedMemory overflows its region");
+
 extern SharedMemory& shared_memory;
 
 #endif/*__PORTAPACK_SHARED_MEMORY_H__*/
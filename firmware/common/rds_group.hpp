@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __RDS_GROUP_H__
+#define __RDS_GROUP_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace rds {
+
+/* One RDS group, as four 16-bit information words (blocks A, B, C/C', D).
+ * Check words have already been verified (and corrected, where noted in
+ * corrected_blocks) by the baseband.
+ */
+struct Group {
+	std::array<uint16_t, 4> blocks { };
+	uint8_t corrected_blocks { 0 };
+
+	uint16_t pi() const {
+		return blocks[0];
+	}
+
+	uint8_t group_type() const {
+		return blocks[1] >> 12;
+	}
+
+	/* false: version A, true: version B. */
+	bool version_b() const {
+		return (blocks[1] >> 11) & 1;
+	}
+
+	bool traffic_program() const {
+		return (blocks[1] >> 10) & 1;
+	}
+
+	uint8_t program_type() const {
+		return (blocks[1] >> 5) & 0x1f;
+	}
+
+	/* Group 0A/0B: program service name, two characters per group. */
+	size_t ps_segment_address() const {
+		return blocks[1] & 0x3;
+	}
+
+	std::array<char, 2> ps_segment() const {
+		return { { static_cast<char>(blocks[3] >> 8), static_cast<char>(blocks[3] & 0xff) } };
+	}
+
+	/* Group 2A/2B: radiotext, four (2A) or two (2B) characters per group. */
+	size_t rt_segment_address() const {
+		return blocks[1] & 0xf;
+	}
+
+	bool rt_ab_flag() const {
+		return (blocks[1] >> 4) & 1;
+	}
+
+	std::array<char, 4> rt_segment() const {
+		if( version_b() ) {
+			return { {
+				static_cast<char>(blocks[3] >> 8), static_cast<char>(blocks[3] & 0xff),
+				0, 0
+			} };
+		} else {
+			return { {
+				static_cast<char>(blocks[2] >> 8), static_cast<char>(blocks[2] & 0xff),
+				static_cast<char>(blocks[3] >> 8), static_cast<char>(blocks[3] & 0xff)
+			} };
+		}
+	}
+
+	/* Group 4A: clock time, as Modified Julian Day and UTC hour/minute.
+	 * Local offset is in signed half-hours.
+	 */
+	uint32_t ct_mjd() const {
+		return ((blocks[1] & 0x3) << 15) | (blocks[2] >> 1);
+	}
+
+	uint8_t ct_hour() const {
+		return ((blocks[2] & 0x1) << 4) | (blocks[3] >> 12);
+	}
+
+	uint8_t ct_minute() const {
+		return (blocks[3] >> 6) & 0x3f;
+	}
+
+	int8_t ct_local_offset() const {
+		const int8_t magnitude = blocks[3] & 0x1f;
+		return (blocks[3] & 0x20) ? -magnitude : magnitude;
+	}
+};
+
+} /* namespace rds */
+
+#endif/*__RDS_GROUP_H__*/
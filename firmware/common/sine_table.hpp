@@ -25,6 +25,7 @@
 // TODO: Including only for pi. Need separate math.hpp...
 #include "complex.hpp"
 
+#include <cstdint>
 #include <array>
 #include <cmath>
 
@@ -146,4 +147,32 @@ inline float sin_f32(const float w) {
 	return result;
 }
 
+/* Q15 version of sine_table_f32, for fixed-point oscillators. */
+constexpr std::array<int16_t, sine_table_f32_period + 1> make_sine_table_s16() {
+	std::array<int16_t, sine_table_f32_period + 1> result { };
+	for(size_t i=0; i<result.size(); i++) {
+		const float v = sine_table_f32[i] * 32767.0f;
+		result[i] = (v < 0.0f) ? (v - 0.5f) : (v + 0.5f);
+	}
+	return result;
+}
+
+constexpr std::array<int16_t, sine_table_f32_period + 1> sine_table_s16 = make_sine_table_s16();
+
+/* Phase is unsigned 32-bit, full scale == 2 * pi. Result is Q15, linearly
+ * interpolated between table entries using the next 8 bits of phase.
+ */
+inline int32_t sin_s16(const uint32_t phase) {
+	const uint32_t n_int = phase >> (32 - sine_table_f32_period_log2);
+	const int32_t n_frac = (phase >> (24 - sine_table_f32_period_log2)) & 0xff;
+
+	const int32_t p0 = sine_table_s16[n_int + 0];
+	const int32_t p1 = sine_table_s16[n_int + 1];
+	return p0 + (((p1 - p0) * n_frac) >> 8);
+}
+
+inline int32_t cos_s16(const uint32_t phase) {
+	return sin_s16(phase + 0x40000000U);
+}
+
 #endif/*__SINE_TABLE_H__*/
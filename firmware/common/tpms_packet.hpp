@@ -31,7 +31,6 @@
 using units::Temperature;
 using units::Pressure;
 
-#include "baseband_packet.hpp"
 #include "manchester.hpp"
 #include "field_reader.hpp"
 
@@ -134,13 +133,12 @@ private:
 
 class Packet {
 public:
-	constexpr Packet(
-		const baseband::Packet& packet,
+	Packet(
+		const ManchesterPacket& packet,
 		const SignalType signal_type
 	) : packet_ { packet },
 		signal_type_ { signal_type },
-		decoder_ { packet_, 0 },
-		reader_ { decoder_ }
+		reader_ { packet_ }
 	{
 	}
 
@@ -152,11 +150,10 @@ public:
 	Optional<Reading> reading() const;
 
 private:
-	using Reader = FieldReader<ManchesterDecoder, BitRemapNone>;
+	using Reader = FieldReader<ManchesterPacket, BitRemapNone>;
 
-	const baseband::Packet packet_;
+	const ManchesterPacket packet_;
 	const SignalType signal_type_;
-	const ManchesterDecoder decoder_;
 
 	const Reader reader_;
 
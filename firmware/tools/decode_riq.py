@@ -0,0 +1,111 @@
+#!/usr/bin/env python
+
+#
+# Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+#
+# This file is part of PortaPack.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+# Block format is described in baseband/iq_codec.hpp.
+
+import sys
+import struct
+
+usage_message = """
+PortaPack compressed capture decoder
+
+Usage: <command> <input .RIQ> <output .C16>
+"""
+
+header_format = '<IHBBhhI'
+header_size = struct.calcsize(header_format)
+
+block_magic = 0x31514952
+k_raw = 0xff
+escape_quotient = 24
+escape_bits = 17
+
+def unzigzag(v):
+	return (v >> 1) ^ -(v & 1)
+
+def wrap_s16(v):
+	return ((v + 0x8000) & 0xffff) - 0x8000
+
+def decode_rice(bits, pos, k):
+	end_of_ones = bits.find('0', pos, pos + escape_quotient)
+	if end_of_ones < 0:
+		pos += escape_quotient
+		v = int(bits[pos:pos + escape_bits], 2)
+		return v, pos + escape_bits
+	q = end_of_ones - pos
+	pos = end_of_ones + 1
+	r = int(bits[pos:pos + k], 2) if k else 0
+	return (q << k) | r, pos + k
+
+def decode_block(sample_count, k_i, k_q, first_i, first_q, payload):
+	samples = [(first_i, first_q)]
+	if k_i == k_raw:
+		values = struct.unpack('<%dh' % (len(payload) // 2), payload)
+		samples.extend(zip(values[0::2], values[1::2]))
+		return samples
+
+	words = struct.unpack('<%dI' % (len(payload) // 4), payload)
+	bits = ''.join('{0:032b}'.format(w) for w in words)
+	pos = 0
+	i, q = first_i, first_q
+	for n in range(1, sample_count):
+		d_i, pos = decode_rice(bits, pos, k_i)
+		d_q, pos = decode_rice(bits, pos, k_q)
+		i = wrap_s16(i + unzigzag(d_i))
+		q = wrap_s16(q + unzigzag(d_q))
+		samples.append((i, q))
+	return samples
+
+def decode(data):
+	magic_bytes = struct.pack('<I', block_magic)
+	offset = 0
+	while offset + header_size <= len(data):
+		magic, sample_count, k_i, k_q, first_i, first_q, payload_size = struct.unpack_from(header_format, data, offset)
+		next_offset = offset + header_size + payload_size
+		if next_offset > len(data):
+			# Capture ended mid-block.
+			break
+		if (magic != block_magic) or ((next_offset < len(data)) and (data[next_offset:next_offset + 4] != magic_bytes)):
+			# Bytes were dropped during capture. Resynchronize on the next block.
+			sys.stderr.write('skipping damaged block at offset %d\n' % offset)
+			offset = data.find(magic_bytes, offset + 1)
+			if offset < 0:
+				break
+			continue
+		payload = data[offset + header_size:next_offset]
+		offset = next_offset
+		if sample_count:
+			yield decode_block(sample_count, k_i, k_q, first_i, first_q, payload)
+
+if len(sys.argv) != 3:
+	print(usage_message)
+	sys.exit(-1)
+
+f = open(sys.argv[1], 'rb')
+data = f.read()
+f.close()
+
+f = open(sys.argv[2], 'wb')
+for samples in decode(data):
+	f.write(struct.pack('<%dh' % (len(samples) * 2), *[v for sample in samples for v in sample]))
+f.close()
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Stand-in for the CMSIS intrinsics iq_codec.cpp uses, for host builds. */
+
+#ifndef __HAL_H__
+#define __HAL_H__
+
+#include <cstdint>
+
+static inline uint32_t __CLZ(const uint32_t value) {
+	return value ? __builtin_clz(value) : 32;
+}
+
+#endif/*__HAL_H__*/
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host build of the baseband .RIQ encoder, for testing decode_riq.py.
+ * Encodes a .C16 file in blocks of block_samples, as proc_capture does.
+ * See test_riq_roundtrip.py.
+ */
+
+#include "iq_codec.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+	if( (argc < 3) || (argc > 4) ) {
+		fprintf(stderr, "Usage: %s <input .C16> <output .RIQ> [block_samples]\n", argv[0]);
+		return 1;
+	}
+
+	const size_t block_samples = (argc == 4) ? strtoul(argv[3], nullptr, 0) : 512;
+	if( (block_samples == 0) || (block_samples > 16384) ) {
+		fprintf(stderr, "block_samples must be 1 to 16384\n");
+		return 1;
+	}
+
+	FILE* const in = fopen(argv[1], "rb");
+	if( !in ) {
+		perror(argv[1]);
+		return 1;
+	}
+	FILE* const out = fopen(argv[2], "wb");
+	if( !out ) {
+		perror(argv[2]);
+		fclose(in);
+		return 1;
+	}
+
+	std::vector<complex16_t> samples(block_samples);
+	std::vector<uint32_t> block(iq_codec::block_size_max(block_samples) / sizeof(uint32_t));
+	size_t count;
+	while( (count = fread(samples.data(), sizeof(complex16_t), block_samples, in)) > 0 ) {
+		const size_t length = iq_codec::encode(samples.data(), count, block.data());
+		fwrite(block.data(), 1, length, out);
+	}
+
+	fclose(out);
+	fclose(in);
+	return 0;
+}
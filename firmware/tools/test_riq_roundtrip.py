@@ -0,0 +1,125 @@
+#!/usr/bin/env python
+
+#
+# Copyright (C) 2016 Jared Boone, ShareBrained Technology, Inc.
+#
+# This file is part of PortaPack.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+# Builds the baseband .RIQ encoder for the host, encodes test signals and
+# checks that decode_riq.py gives back exactly the input.
+
+import math
+import os
+import random
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+usage_message = """
+PortaPack compressed capture round-trip test
+
+Usage: <command> [C++ compiler, default $CXX or c++]
+"""
+
+tools_path = os.path.dirname(os.path.abspath(__file__))
+firmware_path = os.path.dirname(tools_path)
+
+def build_encoder(compiler, output_path):
+	subprocess.check_call([
+		compiler, '-std=c++17', '-O2',
+		'-I', os.path.join(tools_path, 'riq_encode'),
+		'-I', os.path.join(firmware_path, 'baseband'),
+		'-I', os.path.join(firmware_path, 'common'),
+		os.path.join(tools_path, 'riq_encode', 'riq_encode.cpp'),
+		os.path.join(firmware_path, 'baseband', 'iq_codec.cpp'),
+		'-o', output_path,
+	])
+
+def clamp_s16(v):
+	return max(-32768, min(32767, int(v)))
+
+def test_signals(rng):
+	# Each entry is (name, samples, block_samples).
+	noise = [(clamp_s16(rng.gauss(0, 300)), clamp_s16(rng.gauss(0, 300))) for n in range(8192)]
+	yield 'noise', noise, 512
+
+	tone = [(clamp_s16(8000 * math.cos(0.05 * n) + rng.randint(0, 63)), clamp_s16(8000 * math.sin(0.05 * n))) for n in range(8192)]
+	yield 'tone', tone, 512
+
+	# Incompressible: blocks fall back to raw samples.
+	full_scale = [(rng.randint(-32768, 32767), rng.randint(-32768, 32767)) for n in range(4096)]
+	yield 'full scale random', full_scale, 512
+
+	# Largest possible differences: escapes and 16-bit wrap.
+	extremes = [(32767 if (n & 1) else -32768, -32768 if (n & 2) else 32767) for n in range(4096)]
+	yield 'extremes', extremes, 512
+
+	silence = [(0, 0)] * 2048
+	yield 'silence', silence, 512
+
+	# Short final block, odd block length.
+	yield 'short blocks', noise[:1000], 333
+
+	yield 'single sample blocks', tone[:64], 1
+
+def main():
+	if len(sys.argv) > 2:
+		print(usage_message)
+		return -1
+
+	compiler = sys.argv[1] if len(sys.argv) == 2 else os.environ.get('CXX', 'c++')
+	work_path = tempfile.mkdtemp(prefix='riq_roundtrip_')
+	failures = 0
+	try:
+		encoder_path = os.path.join(work_path, 'riq_encode')
+		build_encoder(compiler, encoder_path)
+
+		rng = random.Random(1)
+		for name, samples, block_samples in test_signals(rng):
+			input_path = os.path.join(work_path, 'input.c16')
+			riq_path = os.path.join(work_path, 'capture.riq')
+			output_path = os.path.join(work_path, 'output.c16')
+
+			raw = struct.pack('<%dh' % (len(samples) * 2), *[v for sample in samples for v in sample])
+			f = open(input_path, 'wb')
+			f.write(raw)
+			f.close()
+
+			subprocess.check_call([encoder_path, input_path, riq_path, str(block_samples)])
+			subprocess.check_call([sys.executable, os.path.join(tools_path, 'decode_riq.py'), riq_path, output_path])
+
+			f = open(output_path, 'rb')
+			decoded = f.read()
+			f.close()
+
+			compressed_size = os.path.getsize(riq_path)
+			if decoded == raw:
+				print('ok   %-22s %7d -> %7d bytes' % (name, len(raw), compressed_size))
+			else:
+				print('FAIL %-22s decoded %d of %d bytes differently' % (name, len(decoded), len(raw)))
+				failures += 1
+	finally:
+		shutil.rmtree(work_path)
+
+	return 1 if failures else 0
+
+if __name__ == '__main__':
+	sys.exit(main())